@@ -0,0 +1,104 @@
+/**************************************************************************************************
+*
+*   File name :			batch.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the batch shortest path queries, implemented in batch.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Answers many (source, target) shortest distance queries against one graph at once. The
+*	queries are spread over the workers of a ThreadPool, each worker running DijkstraSearch
+*	with its own Workspace, so the graph is shared read-only and nothing is locked. Nothing is
+*	printed; each answer is written to its own slot of the result array.
+*
+*	Structs:
+*		PathResult			the distance of one query and, if asked for, its path
+*
+*	Class Names:
+*		PotentialGraph		a view of a graph with one more vertex, joined to every vertex by
+*							an edge of weight 0, used to find Johnson's potentials
+*		ReweightedGraph		a view of a graph with each edge u to v reweighted by the
+*							potentials to w + h(u) - h(v), which is never negative
+*
+*	Functions:
+*		BatchShortestDistance	answers a vector of (source, target) queries in parallel
+*		AllPairsShortestDistance	Johnson's algorithm: one Ford search for the potentials,
+*								then Dijkstra from every source in parallel
+*
+****************************************************************************************************/
+
+#ifndef BATCH_H
+#define BATCH_H
+#include <vector>
+#include <utility>
+#include "search.h"
+#include "threadpool.h"
+
+struct PathResult
+{
+	double distance;			// Shortest distance, UNREACHABLE if there is no path
+	std::vector<int> path;		// Vertex indices from source to target, if paths were asked for
+};
+
+// Answers each (source, target) query in queries with Dijkstra's algorithm, using
+// every worker of pool. results[i] is the answer to queries[i]; paths are only
+// filled in when wantPaths is true. Works on any graph type the engines in search.h
+// accept, such as Graph or CSRGraph.
+template <class Adj>
+void BatchShortestDistance(const Adj &graph, const std::vector<std::pair<int, int> > &queries,
+	std::vector<PathResult> &results, bool wantPaths, ThreadPool &pool);
+
+template <class Adj>
+class PotentialGraph
+{
+public:
+	PotentialGraph(const Adj &g);		// Constructor
+
+	// The vertices of the graph plus the added vertex, which is VertexCount() - 1
+	int VertexCount() const;
+
+	template <class F>
+	void ForEachEdge(int u, F visit) const;
+	template <class F>
+	bool ForEachEdgeUntil(int u, F visit) const;
+
+private:
+	const Adj &graph;
+};
+
+template <class Adj>
+class ReweightedGraph
+{
+public:
+	// h holds the potential of each vertex, such as the distances from the added
+	// vertex of a PotentialGraph
+	ReweightedGraph(const Adj &g, const std::vector<double> &h);
+
+	int VertexCount() const;
+
+	template <class F>
+	void ForEachEdge(int u, F visit) const;
+
+private:
+	const Adj &graph;
+	const std::vector<double> &potential;
+};
+
+// Shortest distances between every pair of vertices by Johnson's algorithm, which
+// allows negative edge weights. One FordSearch from the added vertex of a
+// PotentialGraph gives potentials that make every edge weight non-negative, then
+// DijkstraSearch runs from each source on the ReweightedGraph, one source per worker
+// at a time. matrix is resized to V * V and matrix[s * V + t] is the distance from s
+// to t (UNREACHABLE if there is no path). Returns false, with the vertices of a
+// negative cycle in cycle and matrix left empty, if the distances are unbounded.
+// O(VE + V (V + E) log V) work.
+template <class Adj>
+bool AllPairsShortestDistance(const Adj &graph, std::vector<double> &matrix, std::vector<int> &cycle,
+	ThreadPool &pool);
+
+#include "batch.t"
+#endif // !BATCH_H
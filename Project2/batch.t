@@ -0,0 +1,215 @@
+/**************************************************************************************************
+*
+*   File name :			batch.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementation of the batch shortest path queries defined in batch.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef BATCH_T
+#define BATCH_T
+
+/*******************************************************************************************
+*	Function Name:			BatchShortestDistance
+*	Purpose:				answers a batch of shortest distance queries in parallel. Each
+*							worker has its own Workspace and takes queries a chunk at a
+*							time, writing each answer straight into its result slot
+*	Input Parameters:		const Adj &graph						the graph to search
+*							const vector<pair<int, int> > &queries	(source, target) indices
+*							vector<PathResult> &results				filled with one answer per query
+*							bool wantPaths							whether to fill in the paths
+*							ThreadPool &pool						the workers to use
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void BatchShortestDistance(const Adj &graph, const std::vector<std::pair<int, int> > &queries,
+	std::vector<PathResult> &results, bool wantPaths, ThreadPool &pool)
+{
+	std::vector<Workspace> spaces(pool.Size());
+
+	results.resize(queries.size());
+
+	//small chunks keep the workers balanced when some queries search much further than others
+	pool.ParallelFor(queries.size(), 16, [&](int worker, int i)
+	{
+		Workspace &ws = spaces[worker];
+		int source = queries[i].first;
+		int target = queries[i].second;
+		PathResult &result = results[i];
+
+		result.path.clear();
+		result.distance = DijkstraSearch(graph, source, target, ws);
+		if (!wantPaths || result.distance == UNREACHABLE)
+			return;
+
+		//walk back from the target, then put the path in source to target order
+		for (int at = target; at != -1; at = ws.Prev(at))
+			result.path.push_back(at);
+		for (unsigned j = 0; j < result.path.size() / 2; j++)
+			std::swap(result.path[j], result.path[result.path.size() - 1 - j]);
+	});
+}
+
+/*******************************************************************************************
+*	Function Name:			PotentialGraph()		the constructor
+*	Purpose:				creates a view of a graph with one added vertex
+*	Input Parameters:		const Adj &g	the graph
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+PotentialGraph<Adj>::PotentialGraph(const Adj &g) : graph(g)
+{
+
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexCount
+*	Purpose:				the number of vertices, counting the added one
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class Adj>
+int PotentialGraph<Adj>::VertexCount() const
+{
+	return graph.VertexCount() + 1;
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdge
+*	Purpose:				visits the edges of a vertex of the graph, or the weight 0 edges
+*							from the added vertex to every other vertex
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight)
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+template <class F>
+void PotentialGraph<Adj>::ForEachEdge(int u, F visit) const
+{
+	if (u < graph.VertexCount())
+	{
+		graph.ForEachEdge(u, visit);
+		return;
+	}
+	for (int v = 0; v < graph.VertexCount(); v++)
+		visit(v, 0.0);
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdgeUntil
+*	Purpose:				like ForEachEdge, stopping when visit returns true
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight), returning bool
+*	Return value:			bool	true if visit returned true for some edge
+********************************************************************************************/
+template <class Adj>
+template <class F>
+bool PotentialGraph<Adj>::ForEachEdgeUntil(int u, F visit) const
+{
+	if (u < graph.VertexCount())
+		return graph.ForEachEdgeUntil(u, visit);
+	for (int v = 0; v < graph.VertexCount(); v++)
+	{
+		if (visit(v, 0.0))
+			return true;
+	}
+	return false;
+}
+
+/*******************************************************************************************
+*	Function Name:			ReweightedGraph()		the constructor
+*	Purpose:				creates a reweighted view of a graph
+*	Input Parameters:		const Adj &g					the graph
+*							const vector<double> &h			the potential of each vertex
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+ReweightedGraph<Adj>::ReweightedGraph(const Adj &g, const std::vector<double> &h) : graph(g), potential(h)
+{
+
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexCount
+*	Purpose:				the number of vertices of the graph
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class Adj>
+int ReweightedGraph<Adj>::VertexCount() const
+{
+	return graph.VertexCount();
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdge
+*	Purpose:				visits the edges of a vertex with their weights shifted by the
+*							potentials of their ends
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight)
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+template <class F>
+void ReweightedGraph<Adj>::ForEachEdge(int u, F visit) const
+{
+	double hu = potential[u];
+	graph.ForEachEdge(u, [&](int v, double weight)
+	{
+		visit(v, weight + hu - potential[v]);
+	});
+}
+
+/*******************************************************************************************
+*	Function Name:			AllPairsShortestDistance
+*	Purpose:				Johnson's all-pairs shortest paths. The distances from the added
+*							vertex of a PotentialGraph are the potentials; they are at most 0
+*							and satisfy h(v) <= h(u) + w for every edge, so the reweighted
+*							edges are non-negative and Dijkstra applies. A distance found on
+*							the reweighted graph is shifted back by h(t) - h(s).
+*	Input Parameters:		const Adj &graph			the graph
+*							vector<double> &matrix		filled with the V * V distances
+*							vector<int> &cycle			filled with a negative cycle, if found
+*							ThreadPool &pool			the workers to use
+*	Return value:			bool	false if a negative cycle makes the distances unbounded
+********************************************************************************************/
+template <class Adj>
+bool AllPairsShortestDistance(const Adj &graph, std::vector<double> &matrix, std::vector<int> &cycle,
+	ThreadPool &pool)
+{
+	int n = graph.VertexCount();
+	PotentialGraph<Adj> extended(graph);
+	std::vector<double> potential(n);
+	std::vector<Workspace> spaces(pool.Size());
+
+	//one label-correcting search gives every potential, or finds a negative cycle
+	matrix.clear();
+	if (!FordSearch(extended, n, spaces[0], cycle))
+		return false;
+	for (int v = 0; v < n; v++)
+		potential[v] = spaces[0].Dist(v);
+
+	//one Dijkstra search per source on the reweighted graph, each filling its own row
+	ReweightedGraph<Adj> reweighted(graph, potential);
+	matrix.assign((size_t)n * n, UNREACHABLE);
+	pool.ParallelFor(n, 1, [&](int worker, int s)
+	{
+		Workspace &ws = spaces[worker];
+		double *row = &matrix[(size_t)s * n];
+
+		DijkstraSearch(reweighted, s, -1, ws);
+		const std::vector<int> &reached = ws.Touched();
+		for (unsigned k = 0; k < reached.size(); k++)
+		{
+			int t = reached[k];
+			row[t] = ws.Dist(t) - potential[s] + potential[t];
+		}
+	});
+	return true;
+}
+
+#endif // !BATCH_T
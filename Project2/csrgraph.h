@@ -0,0 +1,125 @@
+/**************************************************************************************************
+*
+*   File name :			csrgraph.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the CSRGraph class, implemented in csrgraph.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		CSRGraph
+*
+*	A read-only snapshot of a Graph in compressed sparse row form, made by Graph::Freeze. The
+*	edges of vertex u are entries offsets[u] to offsets[u + 1] - 1 of the targets and weights
+*	arrays, so a traversal reads contiguous memory instead of following list nodes. The snapshot
+*	does not change when the Graph it was made from changes.
+*
+*	Private data members:
+*		vector<nameType> names			the name of each vertex, by index
+*		vector<int> offsets				where the edges of each vertex start, plus the edge count
+*		vector<int> targets				the target vertex index of each edge
+*		vector<weightType> weights		the weight of each edge
+*		vertexIndex						hash index from a vertex name to its index
+*
+*	Public member functions:
+*		CSRGraph			constructor for an empty snapshot
+*		VertexCount			the number of vertices
+*		EdgeCount			the number of edges
+*		Degree				the number of edges leaving a vertex
+*		Find				the index of a vertex name, -1 if it is not in the snapshot
+*		Name				the name of a vertex index
+*		ForEachEdge			visits the target index and weight of each edge leaving a vertex
+*		ForEachEdgeUntil	visits the edges leaving a vertex until the visitor returns true
+*		Transpose			a snapshot with every edge reversed
+*		ShortestDistance	Dijkstra's shortest distance and path between two vertices
+*		BFTraversal			breadth first visiting order from a vertex
+*		DFTraversal			depth first visiting order from a vertex
+*		MST					Prim's minimum spanning tree of a vertex's component
+*		FordShortestPath	Ford's shortest paths from a vertex, allowing negative weights
+*
+****************************************************************************************************/
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+#include <vector>
+#include <unordered_map>
+#include "search.h"
+
+template <class V, class W>
+class Graph;
+
+template <class V, class W> // V is the vertex class; W is edge weight class
+class CSRGraph
+{
+public:
+	typedef typename V::nameType nameType;
+	typedef typename W::weightType weightType;
+
+	CSRGraph();		// Constructor, an empty snapshot
+
+	int VertexCount() const;	// Number of vertices
+	int EdgeCount() const;		// Number of edges
+	int Degree(int u) const;	// Number of edges leaving vertex index u
+
+	// Index of the vertex with the given name, -1 if it is not in the snapshot
+	int Find(const nameType &name) const;
+
+	// Name of vertex index v
+	const nameType &Name(int v) const;
+
+	// Calls visit(target index, weight) for each edge leaving vertex index u
+	template <class F>
+	void ForEachEdge(int u, F visit) const;
+
+	// Like ForEachEdge, but stops at the first edge for which visit returns true.
+	// Returns whether it stopped early.
+	template <class F>
+	bool ForEachEdgeUntil(int u, F visit) const;
+
+	// Returns a snapshot with the same vertices and every edge reversed, so the
+	// edges leaving u in it are the edges entering u here. O(V + E)
+	CSRGraph Transpose() const;
+
+	// The queries below only read the snapshot. The overloads taking a Workspace reuse
+	// its scratch arrays, so a thread running many queries keeps one Workspace; the
+	// others make a Workspace for the one query.
+
+	// Returns the shortest distance from source to target (UNREACHABLE if there is
+	// none) and fills path with the vertex indices from source to target. Dijkstra.
+	double ShortestDistance(int source, int target, std::vector<int> &path) const;
+	double ShortestDistance(int source, int target, std::vector<int> &path, Workspace &ws) const;
+
+	// Fills order with the vertex indices in breadth first order from source
+	void BFTraversal(int source, std::vector<int> &order) const;
+	void BFTraversal(int source, std::vector<int> &order, Workspace &ws) const;
+
+	// Fills order with the vertex indices in depth first order from source
+	void DFTraversal(int source, std::vector<int> &order) const;
+	void DFTraversal(int source, std::vector<int> &order, Workspace &ws) const;
+
+	// Prim's algorithm from source. parent receives the tree parent of each vertex
+	// (-1 for source and vertices outside its component); returns the tree weight.
+	double MST(int source, std::vector<int> &parent) const;
+	double MST(int source, std::vector<int> &parent, Workspace &ws) const;
+
+	// Ford's algorithm from source; fills the distance to each vertex and the
+	// previous vertex on its path. Returns false, with the vertices of a negative
+	// cycle reachable from source in cycle, if the distances are unbounded.
+	bool FordShortestPath(int source, std::vector<double> &dist, std::vector<int> &prev, std::vector<int> &cycle) const;
+	bool FordShortestPath(int source, std::vector<double> &dist, std::vector<int> &prev, std::vector<int> &cycle,
+		Workspace &ws) const;
+
+private:
+	friend class Graph<V, W>;
+
+	std::vector<nameType> names;
+	std::vector<int> offsets;
+	std::vector<int> targets;
+	std::vector<weightType> weights;
+	std::unordered_map<nameType, int> vertexIndex;
+};
+#include "csrgraph.t"
+#endif // !CSRGRAPH_H
@@ -0,0 +1,337 @@
+/**************************************************************************************************
+*
+*   File name :			csrgraph.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the functions for the compressed sparse row graph snapshot
+*	defined in csrgraph.h. The queries run the engines in search.h over the snapshot arrays.
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef CSRGRAPH_T
+#define CSRGRAPH_T
+
+/*******************************************************************************************
+*	Function Name:			CSRGraph()			the constructor
+*	Purpose:				creates an empty snapshot with no vertices
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+template <class V, class W>
+CSRGraph<V, W>::CSRGraph()
+{
+	offsets.push_back(0);
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexCount
+*	Purpose:				the number of vertices in the snapshot
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int CSRGraph<V, W>::VertexCount() const
+{
+	return names.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			EdgeCount
+*	Purpose:				the number of edges in the snapshot
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int CSRGraph<V, W>::EdgeCount() const
+{
+	return targets.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			Degree
+*	Purpose:				the number of edges leaving a vertex
+*	Input Parameters:		int u	index of the vertex
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int CSRGraph<V, W>::Degree(int u) const
+{
+	return offsets[u + 1] - offsets[u];
+}
+
+/*******************************************************************************************
+*	Function Name:			Find
+*	Purpose:				looks up the index of a vertex by name
+*	Input Parameters:		const nameType &name	the name of the vertex
+*	Return value:			int		the index of the vertex, -1 if it is not in the snapshot
+********************************************************************************************/
+template <class V, class W>
+int CSRGraph<V, W>::Find(const nameType &name) const
+{
+	typename std::unordered_map<nameType, int>::const_iterator found = vertexIndex.find(name);
+	if (found == vertexIndex.end())
+		return -1;
+	return found->second;
+}
+
+/*******************************************************************************************
+*	Function Name:			Name
+*	Purpose:				the name of a vertex
+*	Input Parameters:		int v	index of the vertex
+*	Return value:			const nameType &
+********************************************************************************************/
+template <class V, class W>
+const typename CSRGraph<V, W>::nameType &CSRGraph<V, W>::Name(int v) const
+{
+	return names[v];
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdge
+*	Purpose:				calls visit with the target index and weight of each edge
+*							leaving a vertex, reading the contiguous row of that vertex
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight)
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+template <class F>
+void CSRGraph<V, W>::ForEachEdge(int u, F visit) const
+{
+	for (int e = offsets[u]; e < offsets[u + 1]; e++)
+		visit(targets[e], weights[e]);
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdgeUntil
+*	Purpose:				calls visit with the target index and weight of each edge
+*							leaving a vertex until visit returns true
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight), returning bool
+*	Return value:			bool	true if visit returned true for some edge
+********************************************************************************************/
+template <class V, class W>
+template <class F>
+bool CSRGraph<V, W>::ForEachEdgeUntil(int u, F visit) const
+{
+	for (int e = offsets[u]; e < offsets[u + 1]; e++)
+	{
+		if (visit(targets[e], weights[e]))
+			return true;
+	}
+	return false;
+}
+
+/*******************************************************************************************
+*	Function Name:			Transpose
+*	Purpose:				builds the reversed snapshot with a counting sort of the edges
+*							by target: count the edges entering each vertex, turn the counts
+*							into offsets, then place each edge in its target's row
+*	Input Parameters:		none
+*	Return value:			CSRGraph	the snapshot with every edge reversed
+********************************************************************************************/
+template <class V, class W>
+CSRGraph<V, W> CSRGraph<V, W>::Transpose() const
+{
+	CSRGraph reversed;
+	int n = VertexCount();
+	std::vector<int> next;		//the next free slot in each target's row
+
+	reversed.names = names;
+	reversed.vertexIndex = vertexIndex;
+	reversed.offsets.assign(n + 1, 0);
+	reversed.targets.resize(targets.size());
+	reversed.weights.resize(weights.size());
+
+	//count the edges entering each vertex
+	for (unsigned e = 0; e < targets.size(); e++)
+		reversed.offsets[targets[e] + 1]++;
+	for (int v = 0; v < n; v++)
+		reversed.offsets[v + 1] += reversed.offsets[v];
+
+	//place each edge in the row of the vertex it enters, pointing back at its source
+	next.assign(reversed.offsets.begin(), reversed.offsets.end() - 1);
+	for (int u = 0; u < n; u++)
+	{
+		for (int e = offsets[u]; e < offsets[u + 1]; e++)
+		{
+			int slot = next[targets[e]]++;
+			reversed.targets[slot] = u;
+			reversed.weights[slot] = weights[e];
+		}
+	}
+	return reversed;
+}
+
+/*******************************************************************************************
+*	Function Name:			ShortestDistance
+*	Purpose:				finds the shortest distance and path between two vertices using
+*							Dijkstra's algorithm
+*	Input Parameters:		int source				index of the starting vertex
+*							int target				index of the ending vertex
+*							vector<int> &path		filled with the path from source to target,
+*													empty if there is none
+*							Workspace &ws			scratch space for the search
+*	Return value:			double	the shortest distance, UNREACHABLE if there is no path
+********************************************************************************************/
+template <class V, class W>
+double CSRGraph<V, W>::ShortestDistance(int source, int target, std::vector<int> &path, Workspace &ws) const
+{
+	path.clear();
+	double minDist = DijkstraSearch(*this, source, target, ws);
+	if (minDist == UNREACHABLE)
+		return minDist;
+
+	//walk back from the target, then put the path in source to target order
+	for (int at = target; at != -1; at = ws.Prev(at))
+		path.push_back(at);
+	for (unsigned i = 0; i < path.size() / 2; i++)
+		std::swap(path[i], path[path.size() - 1 - i]);
+
+	return minDist;
+}
+
+/*******************************************************************************************
+*	Function Name:			ShortestDistance
+*	Purpose:				runs the query above with a Workspace made for this one query
+*	Input Parameters:		as above, without the Workspace
+*	Return value:			as above
+********************************************************************************************/
+template <class V, class W>
+double CSRGraph<V, W>::ShortestDistance(int source, int target, std::vector<int> &path) const
+{
+	Workspace ws;
+	return ShortestDistance(source, target, path, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			BFTraversal
+*	Purpose:				breadth first traversal of the snapshot from a vertex
+*	Input Parameters:		int source				index of the starting vertex
+*							vector<int> &order		filled with the visiting order
+*							Workspace &ws			scratch space for the search
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void CSRGraph<V, W>::BFTraversal(int source, std::vector<int> &order, Workspace &ws) const
+{
+	BreadthFirstSearch(*this, source, order, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			BFTraversal
+*	Purpose:				runs the query above with a Workspace made for this one query
+*	Input Parameters:		as above, without the Workspace
+*	Return value:			as above
+********************************************************************************************/
+template <class V, class W>
+void CSRGraph<V, W>::BFTraversal(int source, std::vector<int> &order) const
+{
+	Workspace ws;
+	BFTraversal(source, order, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			DFTraversal
+*	Purpose:				depth first traversal of the snapshot from a vertex
+*	Input Parameters:		int source				index of the starting vertex
+*							vector<int> &order		filled with the visiting order
+*							Workspace &ws			scratch space for the search
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void CSRGraph<V, W>::DFTraversal(int source, std::vector<int> &order, Workspace &ws) const
+{
+	DepthFirstSearch(*this, source, order, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			DFTraversal
+*	Purpose:				runs the query above with a Workspace made for this one query
+*	Input Parameters:		as above, without the Workspace
+*	Return value:			as above
+********************************************************************************************/
+template <class V, class W>
+void CSRGraph<V, W>::DFTraversal(int source, std::vector<int> &order) const
+{
+	Workspace ws;
+	DFTraversal(source, order, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			MST
+*	Purpose:				finds the minimum spanning tree of the component of a vertex
+*							using Prim's algorithm
+*	Input Parameters:		int source				index of the starting vertex
+*							vector<int> &parent		filled with the tree parent of each vertex
+*							Workspace &ws			scratch space for the search
+*	Return value:			double	the weight of the minimum spanning tree
+********************************************************************************************/
+template <class V, class W>
+double CSRGraph<V, W>::MST(int source, std::vector<int> &parent, Workspace &ws) const
+{
+	double total = PrimSearch(*this, source, ws);
+
+	parent.resize(VertexCount());
+	for (int v = 0; v < VertexCount(); v++)
+		parent[v] = ws.Prev(v);
+	return total;
+}
+
+/*******************************************************************************************
+*	Function Name:			MST
+*	Purpose:				runs the query above with a Workspace made for this one query
+*	Input Parameters:		as above, without the Workspace
+*	Return value:			as above
+********************************************************************************************/
+template <class V, class W>
+double CSRGraph<V, W>::MST(int source, std::vector<int> &parent) const
+{
+	Workspace ws;
+	return MST(source, parent, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			FordShortestPath
+*	Purpose:				finds the shortest paths from a vertex to all other vertices
+*							using Ford's algorithm to handle negative edge weights
+*	Input Parameters:		int source				index of the starting vertex
+*							vector<double> &dist	filled with the distance to each vertex
+*							vector<int> &prev		filled with the previous vertex on each path
+*							vector<int> &cycle		filled with a negative cycle, if one is found
+*							Workspace &ws			scratch space for the search
+*	Return value:			bool	false if a negative cycle is reachable from source
+********************************************************************************************/
+template <class V, class W>
+bool CSRGraph<V, W>::FordShortestPath(int source, std::vector<double> &dist, std::vector<int> &prev, std::vector<int> &cycle,
+	Workspace &ws) const
+{
+	bool bounded = FordSearch(*this, source, ws, cycle);
+
+	dist.resize(VertexCount());
+	prev.resize(VertexCount());
+	for (int v = 0; v < VertexCount(); v++)
+	{
+		dist[v] = ws.Dist(v);
+		prev[v] = ws.Prev(v);
+	}
+	return bounded;
+}
+
+/*******************************************************************************************
+*	Function Name:			FordShortestPath
+*	Purpose:				runs the query above with a Workspace made for this one query
+*	Input Parameters:		as above, without the Workspace
+*	Return value:			as above
+********************************************************************************************/
+template <class V, class W>
+bool CSRGraph<V, W>::FordShortestPath(int source, std::vector<double> &dist, std::vector<int> &prev, std::vector<int> &cycle) const
+{
+	Workspace ws;
+	return FordShortestPath(source, dist, prev, cycle, ws);
+}
+
+#endif // !CSRGRAPH_T
@@ -0,0 +1,60 @@
+/**************************************************************************************************
+*
+*   File name :			disjointsets.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the DisjointSets class, implemented in disjointsets.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		DisjointSets
+*
+*	A union-find structure over vertex indices 0 to n - 1, used to tell whether an edge joins
+*	two different trees of a spanning forest. Find compresses the path it walks and Union links
+*	the root of the shorter tree under the taller one, so a sequence of m operations takes
+*	O(m a(n)) time, where a is the inverse Ackermann function.
+*
+*	Private data members:
+*		vector<int> parent		the parent of each vertex index, itself for a root
+*		vector<int> rank		an upper bound on the height of the tree under each root
+*		int sets				the number of sets
+*
+*	Public member functions:
+*		DisjointSets		constructor for an empty structure
+*		Reset				puts each of the vertex indices 0 to n - 1 in a set of its own
+*		Find				the root of the set holding a vertex index
+*		Union				merges the sets holding two vertex indices
+*		Sets				the number of sets
+*
+****************************************************************************************************/
+
+#ifndef DISJOINTSETS_H
+#define DISJOINTSETS_H
+#include <vector>
+
+class DisjointSets
+{
+public:
+	DisjointSets();		// Constructor
+
+	// Puts each of the vertex indices 0 to n - 1 in a set of its own. O(n)
+	void Reset(int n);
+
+	// Root of the set holding v. Every vertex on the way is relinked to the root.
+	int Find(int v);
+
+	// Merges the sets holding a and b. Returns false if they were already one set.
+	bool Union(int a, int b);
+
+	int Sets() const;	// Number of sets
+
+private:
+	std::vector<int> parent;
+	std::vector<int> rank;
+	int sets;
+};
+#include "disjointsets.t"
+#endif // !DISJOINTSETS_H
@@ -0,0 +1,104 @@
+/**************************************************************************************************
+*
+*   File name :			disjointsets.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the union-find structure defined in disjointsets.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef DISJOINTSETS_T
+#define DISJOINTSETS_T
+
+/*******************************************************************************************
+*	Function Name:			DisjointSets()		the constructor
+*	Purpose:				creates a structure with no vertex indices
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline DisjointSets::DisjointSets()
+{
+	sets = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Reset
+*	Purpose:				puts each vertex index in a set of its own
+*	Input Parameters:		int n	the number of vertex indices
+*	Return value:			void
+********************************************************************************************/
+inline void DisjointSets::Reset(int n)
+{
+	parent.resize(n);
+	rank.assign(n, 0);
+	for (int i = 0; i < n; i++)
+		parent[i] = i;
+	sets = n;
+}
+
+/*******************************************************************************************
+*	Function Name:			Find
+*	Purpose:				finds the root of the set holding a vertex index, then walks the
+*							path again pointing each vertex on it straight at the root
+*	Input Parameters:		int v	the vertex index
+*	Return value:			int		the root of its set
+********************************************************************************************/
+inline int DisjointSets::Find(int v)
+{
+	int root = v;
+	while (parent[root] != root)
+		root = parent[root];
+
+	//compress the path
+	while (parent[v] != root)
+	{
+		int next = parent[v];
+		parent[v] = root;
+		v = next;
+	}
+	return root;
+}
+
+/*******************************************************************************************
+*	Function Name:			Union
+*	Purpose:				merges the sets holding two vertex indices by rank
+*	Input Parameters:		int a	a vertex index
+*							int b	another vertex index
+*	Return value:			bool	false if a and b were already in the same set
+********************************************************************************************/
+inline bool DisjointSets::Union(int a, int b)
+{
+	a = Find(a);
+	b = Find(b);
+	if (a == b)
+		return false;
+
+	//hang the shorter tree under the taller one
+	if (rank[a] < rank[b])
+		parent[a] = b;
+	else if (rank[b] < rank[a])
+		parent[b] = a;
+	else
+	{
+		parent[b] = a;
+		rank[a]++;
+	}
+	sets--;
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			Sets
+*	Purpose:				the number of sets
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int DisjointSets::Sets() const
+{
+	return sets;
+}
+
+#endif // !DISJOINTSETS_T
@@ -0,0 +1,142 @@
+/**************************************************************************************************
+*
+*   File name :			dynamictree.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the graph observers and the DynamicTree class, implemented in dynamictree.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	An observer subscribes to a Graph (Graph::Subscribe) and is told of every change to it,
+*	after the change is made, so it can keep something derived from the graph up to date
+*	without rebuilding it. A change the graph cannot describe edge by edge, such as reading a
+*	new graph, is reported as Reset.
+*
+*	Class Names:
+*		GraphObserver		the interface of an observer
+*		DynamicTree			a shortest path tree from one source, repaired after each change
+*
+*	DynamicTree keeps the distance and previous vertex of every vertex from its source, in the
+*	style of Ramalingam and Reps. A new edge that shortens the path to its end starts a Dijkstra
+*	search from there that only goes as far as distances keep dropping. A removed tree edge
+*	cuts off the subtree below it; each vertex of the subtree takes its best edge from outside
+*	it and a Dijkstra search inside the subtree settles the rest. Either way the work is in
+*	proportion to the vertices whose distances change and their edges, not to the whole graph.
+*	Removing a vertex shifts the vertex indices, so it and Reset recompute the tree.
+*
+*	The tree works on any graph type Adj with a VertexCount() and a ForEachEdge(u, visit), read
+*	when repairing, and keeps its own lists of the edges entering each vertex. Edge weights
+*	must not be negative.
+*
+*	Private data members of DynamicTree:
+*		const Adj &graph				the graph
+*		int source						the index of the source, -1 if it was removed
+*		vector<double> dist				the distance to each vertex, UNREACHABLE if none
+*		vector<int> prev				the previous vertex on each path, -1 for none
+*		vector<vector<InEdge>> in		the edges entering each vertex
+*		MinHeap<double> heap			vertices waiting to be settled during a repair
+*		vector<int> cut					the subtree cut off by a removed edge
+*		vector<char> inCut				marks the vertices of cut
+*		int repaired					the vertices settled by the last change
+*
+*	Private member functions of DynamicTree:
+*		Settle				runs the repair search until the heap is empty
+*		Recompute			rebuilds the edge lists and recomputes the tree
+*
+*	Public member functions of DynamicTree:
+*		DynamicTree			constructor, computes the tree from a source
+*		Source				the index of the source
+*		Dist				the distance to a vertex
+*		Prev				the previous vertex on the path to a vertex
+*		Path				the path from the source to a vertex
+*		Repaired			the vertices settled by the last change, a measure of its cost
+*		EdgeAdded			lowers the distances a new edge shortens
+*		EdgeRemoved			recomputes the subtree below a removed tree edge
+*		VertexAdded			adds an unreachable vertex
+*		VertexRemoved		shifts the indices and recomputes the tree
+*		Reset				recomputes the tree
+*
+****************************************************************************************************/
+
+#ifndef DYNAMICTREE_H
+#define DYNAMICTREE_H
+#include <vector>
+#include <algorithm>
+#include "minheap.h"
+#include "workspace.h"
+
+class GraphObserver
+{
+public:
+	virtual ~GraphObserver() {}
+
+	// An edge from vertex index from to vertex index to with the given weight was added
+	virtual void EdgeAdded(int from, int to, double weight) = 0;
+
+	// One edge from vertex index from to vertex index to with the given weight was removed
+	virtual void EdgeRemoved(int from, int to, double weight) = 0;
+
+	// A vertex with no edges was added at the next index
+	virtual void VertexAdded() = 0;
+
+	// Vertex index v and its edges were removed; the indices above it moved down one
+	virtual void VertexRemoved(int v) = 0;
+
+	// The graph changed in a way not described by the hooks above
+	virtual void Reset() = 0;
+};
+
+template <class Adj>
+class DynamicTree : public GraphObserver
+{
+public:
+	// Computes the shortest path tree of graph from vertex index source. The tree
+	// follows later changes once it is subscribed to the graph, and must be
+	// unsubscribed before it is destroyed. O((V + E) log V)
+	DynamicTree(const Adj &graph, int source);
+
+	int Source() const;				// Index of the source, -1 if it was removed
+	double Dist(int v) const;		// Distance to vertex index v, UNREACHABLE if there is no path
+	int Prev(int v) const;			// Previous vertex on the path to v, -1 for none
+
+	// Fills path with the vertex indices from the source to v; empty if there is no path
+	void Path(int v, std::vector<int> &path) const;
+
+	// Vertices settled by the last change, 0 if it changed no distance
+	int Repaired() const;
+
+	// O(k log k) over the k vertices whose distance drops, and their edges
+	void EdgeAdded(int from, int to, double weight);
+
+	// O(k log k) over the k vertices in the subtree below the edge, and their edges;
+	// O(in-degree of to) if the edge is not in the tree
+	void EdgeRemoved(int from, int to, double weight);
+
+	void VertexAdded();				// O(1)
+	void VertexRemoved(int v);		// O((V + E) log V)
+	void Reset();					// O((V + E) log V)
+
+private:
+	struct InEdge
+	{
+		int from;
+		double weight;
+	};
+
+	void Settle();
+	void Recompute();
+	const Adj &graph;
+	int source;
+	std::vector<double> dist;
+	std::vector<int> prev;
+	std::vector<std::vector<InEdge> > in;
+	MinHeap<double> heap;
+	std::vector<int> cut;
+	std::vector<char> inCut;
+	int repaired;
+};
+#include "dynamictree.t"
+#endif // !DYNAMICTREE_H
@@ -0,0 +1,312 @@
+/**************************************************************************************************
+*
+*   File name :			dynamictree.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the functions for the DynamicTree class defined in
+*	dynamictree.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef DYNAMICTREE_T
+#define DYNAMICTREE_T
+
+/*******************************************************************************************
+*	Function Name:			DynamicTree()			the constructor
+*	Purpose:				computes the shortest path tree of a graph from a source
+*	Input Parameters:		const Adj &graph	the graph, kept by reference
+*							int source			index of the source vertex
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+DynamicTree<Adj>::DynamicTree(const Adj &graph, int source)
+	: graph(graph)
+{
+	this->source = source;
+	Recompute();
+}
+
+/*******************************************************************************************
+*	Function Name:			Recompute
+*	Purpose:				rebuilds the lists of edges entering each vertex and runs
+*							Dijkstra from the source. A source index past the last vertex
+*							means the source is gone.
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::Recompute()
+{
+	int n = graph.VertexCount();
+	in.assign(n, std::vector<InEdge>());
+	for (int u = 0; u < n; u++)
+		graph.ForEachEdge(u, [&](int v, double weight)
+		{
+			InEdge edge = { u, weight };
+			in[v].push_back(edge);
+		});
+
+	dist.assign(n, UNREACHABLE);
+	prev.assign(n, -1);
+	inCut.assign(n, 0);
+	heap.Reset(n);
+	if (source >= n)
+		source = -1;
+
+	repaired = 0;
+	if (source != -1)
+	{
+		dist[source] = 0;
+		heap.Push(source, 0);
+		Settle();
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			Settle
+*	Purpose:				the repair search: Dijkstra from the vertices in the heap, which
+*							only goes on to a vertex when its distance drops
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::Settle()
+{
+	repaired = 0;
+	while (!heap.Empty())
+	{
+		int curr = heap.Pop();
+		double currDist = dist[curr];
+		repaired++;
+
+		graph.ForEachEdge(curr, [&](int next, double weight)
+		{
+			if (currDist + weight < dist[next])
+			{
+				dist[next] = currDist + weight;
+				prev[next] = curr;
+				heap.Push(next, dist[next]);
+			}
+		});
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			Source
+*	Purpose:				the index of the source vertex
+*	Input Parameters:		none
+*	Return value:			int		-1 if the source was removed from the graph
+********************************************************************************************/
+template <class Adj>
+int DynamicTree<Adj>::Source() const
+{
+	return source;
+}
+
+/*******************************************************************************************
+*	Function Name:			Dist
+*	Purpose:				the distance from the source to a vertex
+*	Input Parameters:		int v	the vertex index
+*	Return value:			double	UNREACHABLE if there is no path
+********************************************************************************************/
+template <class Adj>
+double DynamicTree<Adj>::Dist(int v) const
+{
+	return dist[v];
+}
+
+/*******************************************************************************************
+*	Function Name:			Prev
+*	Purpose:				the previous vertex on the shortest path to a vertex
+*	Input Parameters:		int v	the vertex index
+*	Return value:			int		-1 for the source or a vertex with no path
+********************************************************************************************/
+template <class Adj>
+int DynamicTree<Adj>::Prev(int v) const
+{
+	return prev[v];
+}
+
+/*******************************************************************************************
+*	Function Name:			Path
+*	Purpose:				the vertices of the shortest path from the source to a vertex
+*	Input Parameters:		int v					the vertex index
+*							vector<int> &path		receives the path, source first
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::Path(int v, std::vector<int> &path) const
+{
+	path.clear();
+	if (dist[v] == UNREACHABLE)
+		return;
+	for (int at = v; at != -1; at = prev[at])
+		path.push_back(at);
+	std::reverse(path.begin(), path.end());
+}
+
+/*******************************************************************************************
+*	Function Name:			Repaired
+*	Purpose:				the vertices settled by the last change
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class Adj>
+int DynamicTree<Adj>::Repaired() const
+{
+	return repaired;
+}
+
+/*******************************************************************************************
+*	Function Name:			EdgeAdded
+*	Purpose:				records a new edge and, if it shortens the path to its end,
+*							lowers the distances from there on
+*	Input Parameters:		int from		the start of the edge
+*							int to			the end of the edge
+*							double weight	the weight of the edge
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::EdgeAdded(int from, int to, double weight)
+{
+	InEdge edge = { from, weight };
+	in[to].push_back(edge);
+
+	repaired = 0;
+	if (dist[from] + weight < dist[to])
+	{
+		dist[to] = dist[from] + weight;
+		prev[to] = from;
+		heap.Push(to, dist[to]);
+		Settle();
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			EdgeRemoved
+*	Purpose:				forgets a removed edge and, if the tree used it, repairs the
+*							subtree below it. The subtree is found by following the tree
+*							edges down from the end of the edge. Each of its vertices starts
+*							from its best edge from outside the subtree, and the repair
+*							search settles the subtree from those.
+*	Input Parameters:		int from		the start of the edge
+*							int to			the end of the edge
+*							double weight	the weight of the edge
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::EdgeRemoved(int from, int to, double weight)
+{
+	//forget the edge, preferring one with the same weight among parallel edges
+	std::vector<InEdge> &edges = in[to];
+	int found = -1;
+	for (unsigned i = 0; i < edges.size(); i++)
+		if (edges[i].from == from && (found == -1 || edges[i].weight == weight))
+			found = i;
+	if (found != -1)
+	{
+		edges[found] = edges.back();
+		edges.pop_back();
+	}
+
+	//nothing changes unless the tree reached to through the removed edge alone
+	repaired = 0;
+	if (prev[to] != from)
+		return;
+	for (unsigned i = 0; i < edges.size(); i++)
+		if (edges[i].from == from && dist[from] + edges[i].weight == dist[to])
+			return;
+
+	//the subtree below the edge, parents before children
+	cut.assign(1, to);
+	inCut[to] = 1;
+	for (unsigned k = 0; k < cut.size(); k++)
+	{
+		int curr = cut[k];
+		graph.ForEachEdge(curr, [&](int next, double)
+		{
+			if (prev[next] == curr && !inCut[next])
+			{
+				inCut[next] = 1;
+				cut.push_back(next);
+			}
+		});
+	}
+	for (unsigned k = 0; k < cut.size(); k++)
+	{
+		dist[cut[k]] = UNREACHABLE;
+		prev[cut[k]] = -1;
+	}
+
+	//start each vertex of the subtree from its best edge into it from outside
+	for (unsigned k = 0; k < cut.size(); k++)
+	{
+		int v = cut[k];
+		for (unsigned i = 0; i < in[v].size(); i++)
+		{
+			int p = in[v][i].from;
+			if (!inCut[p] && dist[p] + in[v][i].weight < dist[v])
+			{
+				dist[v] = dist[p] + in[v][i].weight;
+				prev[v] = p;
+			}
+		}
+		if (dist[v] != UNREACHABLE)
+			heap.Push(v, dist[v]);
+	}
+
+	for (unsigned k = 0; k < cut.size(); k++)
+		inCut[cut[k]] = 0;
+	Settle();
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexAdded
+*	Purpose:				adds a vertex with no edges, which no path reaches
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::VertexAdded()
+{
+	dist.push_back(UNREACHABLE);
+	prev.push_back(-1);
+	in.push_back(std::vector<InEdge>());
+	inCut.push_back(0);
+	heap.Reset(dist.size());
+	repaired = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexRemoved
+*	Purpose:				follows the source to its new index, or notes it is gone, and
+*							recomputes the tree
+*	Input Parameters:		int v	the index the removed vertex had
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::VertexRemoved(int v)
+{
+	if (source == v)
+		source = -1;
+	else if (source > v)
+		source--;
+	Recompute();
+}
+
+/*******************************************************************************************
+*	Function Name:			Reset
+*	Purpose:				recomputes the tree from the same source index
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DynamicTree<Adj>::Reset()
+{
+	Recompute();
+}
+
+#endif // !DYNAMICTREE_T
@@ -0,0 +1,110 @@
+/**************************************************************************************************
+*
+*   File name :			externalsort.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the ExternalSorter class, implemented in externalsort.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		ExternalSorter
+*
+*	Sorts more records than fit in memory. Records are collected until they take the memory
+*	allowed, then sorted and written to a run file; once every record has been added the runs
+*	are merged through a MinHeap, reading each run in order. Records that fit in memory are
+*	never written out. A record type T needs operator<, Write(ostream &), Read(istream &)
+*	returning false at the end of a run, and Bytes(), the memory it takes.
+*
+*	Private data members:
+*		vector<T> buffer	the records added since the last run was written
+*		size_t used			the memory the records in buffer take
+*		size_t limit		the memory allowed before buffer is written as a run
+*		string prefix		the start of the names of the run files
+*		runs				the names of the run files
+*		int written			the number of run files written, for their names
+*		readers				the open run files while merging
+*		MinHeap<T> heap		the next record of each open run, keyed by the record
+*		size_t next			the next record of buffer while merging without runs
+*		long long count		the number of records added
+*		bool failed			whether a run file could not be written or read
+*
+*	Private member functions:
+*		Spill				sorts buffer and writes it as a run
+*		Open				opens a group of runs for merging
+*		Pop					the smallest record of the open runs
+*		CloseRuns			closes the open runs
+*
+*	Public member functions:
+*		ExternalSorter		constructor, with the memory allowed and the run file prefix
+*		~ExternalSorter		destructor, removes the run files
+*		Add					adds a record
+*		Finish				ends the adding and starts the merge
+*		Next				the next record in sorted order
+*		Count				the number of records added
+*		Runs				the number of runs written
+*		Failed				tests whether a run file could not be written or read
+*
+****************************************************************************************************/
+
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+#include <vector>
+#include <string>
+#include <fstream>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
+#include "minheap.h"
+
+const int MAX_MERGE_RUNS = 64;		// Most runs merged at once; more are merged in groups first
+
+template <class T>
+class ExternalSorter
+{
+public:
+	// Keeps at most about memoryBytes of records in memory, naming the run files
+	// prefix.0, prefix.1, and so on
+	ExternalSorter(std::size_t memoryBytes, const std::string &prefix);
+
+	~ExternalSorter();	// Destructor, removes the run files
+
+	// Adds a record, writing a run first if the records held take the memory allowed.
+	// O(m log m) per run of m records
+	void Add(const T &record);
+
+	// Ends the adding and gets ready to hand out the records in order. With more than
+	// MAX_MERGE_RUNS runs they are merged in groups into fewer, longer runs first.
+	// Returns false if a run file could not be written or read.
+	bool Finish();
+
+	// Sets record to the next record in sorted order; returns false after the last
+	bool Next(T &record);
+
+	long long Count() const;	// Number of records added
+	int Runs() const;			// Number of runs written, 0 if everything fit in memory
+	bool Failed() const;		// Tests whether a run file could not be written or read
+
+private:
+	ExternalSorter(const ExternalSorter &);
+	ExternalSorter &operator=(const ExternalSorter &);
+	bool Spill();
+	bool Open(const std::vector<std::string> &names);
+	bool Pop(T &record);
+	void CloseRuns();
+	std::vector<T> buffer;
+	std::size_t used;
+	std::size_t limit;
+	std::string prefix;
+	std::vector<std::string> runs;
+	int written;
+	std::vector<std::unique_ptr<std::ifstream> > readers;
+	MinHeap<T> heap;
+	std::size_t next;
+	long long count;
+	bool failed;
+};
+#include "externalsort.t"
+#endif // !EXTERNALSORT_H
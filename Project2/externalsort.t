@@ -0,0 +1,265 @@
+/**************************************************************************************************
+*
+*   File name :			externalsort.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the functions for the external merge sort defined in
+*	externalsort.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef EXTERNALSORT_T
+#define EXTERNALSORT_T
+
+/*******************************************************************************************
+*	Function Name:			ExternalSorter()			the constructor
+*	Purpose:				creates a sorter with no records
+*	Input Parameters:		std::size_t memoryBytes		the memory the records held may take
+*							const std::string &prefix	the start of the run file names
+*	Return value:			none
+********************************************************************************************/
+template <class T>
+ExternalSorter<T>::ExternalSorter(std::size_t memoryBytes, const std::string &prefix)
+{
+	used = 0;
+	limit = memoryBytes > sizeof(T) ? memoryBytes : sizeof(T);
+	this->prefix = prefix;
+	written = 0;
+	next = 0;
+	count = 0;
+	failed = false;
+}
+
+/*******************************************************************************************
+*	Function Name:			~ExternalSorter()			the destructor
+*	Purpose:				closes and removes the run files
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+template <class T>
+ExternalSorter<T>::~ExternalSorter()
+{
+	CloseRuns();
+	for (unsigned i = 0; i < runs.size(); i++)
+		std::remove(runs[i].c_str());
+}
+
+/*******************************************************************************************
+*	Function Name:			Add
+*	Purpose:				adds a record, writing the records held as a run once they take
+*							the memory allowed
+*	Input Parameters:		const T &record		the record
+*	Return value:			void
+********************************************************************************************/
+template <class T>
+void ExternalSorter<T>::Add(const T &record)
+{
+	buffer.push_back(record);
+	used += record.Bytes();
+	count++;
+	if (used >= limit)
+		Spill();
+}
+
+/*******************************************************************************************
+*	Function Name:			Finish
+*	Purpose:				ends the adding. Records that all fit in memory are just sorted;
+*							otherwise the rest are written as a last run, groups of runs are
+*							merged while there are too many to open at once, and the runs
+*							left are opened for the merge.
+*	Input Parameters:		none
+*	Return value:			bool	false if a run file could not be written or read
+********************************************************************************************/
+template <class T>
+bool ExternalSorter<T>::Finish()
+{
+	if (runs.empty())
+	{
+		std::sort(buffer.begin(), buffer.end());
+		next = 0;
+		return !failed;
+	}
+
+	//the merge only reads the runs, so give the memory back
+	if (!buffer.empty())
+		Spill();
+	std::vector<T>().swap(buffer);
+
+	while (!failed && runs.size() > (unsigned)MAX_MERGE_RUNS)
+	{
+		std::vector<std::string> merged;
+		unsigned first = 0;
+		for (; first < runs.size() && !failed; first += MAX_MERGE_RUNS)
+		{
+			unsigned last = std::min<unsigned>(first + MAX_MERGE_RUNS, runs.size());
+			std::vector<std::string> group(runs.begin() + first, runs.begin() + last);
+			std::string name = prefix + "." + std::to_string(written++);
+			std::ofstream out(name.c_str(), std::ios::binary | std::ios::trunc);
+			merged.push_back(name);
+
+			//copy the group into one run in order
+			T record;
+			failed = !Open(group) || !out;
+			while (!failed && Pop(record))
+				record.Write(out);
+			CloseRuns();
+			out.close();
+			failed = failed || out.fail();
+			for (unsigned i = 0; i < group.size(); i++)
+				std::remove(group[i].c_str());
+		}
+
+		//keep any runs not merged after a failure, so they are still removed
+		merged.insert(merged.end(), runs.begin() + std::min<unsigned>(first, runs.size()), runs.end());
+		runs = merged;
+	}
+
+	return !failed && Open(runs);
+}
+
+/*******************************************************************************************
+*	Function Name:			Next
+*	Purpose:				the next record in sorted order, from memory or the merge
+*	Input Parameters:		T &record	receives the record
+*	Return value:			bool	false once every record has been handed out
+********************************************************************************************/
+template <class T>
+bool ExternalSorter<T>::Next(T &record)
+{
+	if (runs.empty())
+	{
+		if (next == buffer.size())
+			return false;
+		record = std::move(buffer[next++]);
+		return true;
+	}
+	return Pop(record);
+}
+
+/*******************************************************************************************
+*	Function Name:			Count
+*	Purpose:				the number of records added
+*	Input Parameters:		none
+*	Return value:			long long
+********************************************************************************************/
+template <class T>
+long long ExternalSorter<T>::Count() const
+{
+	return count;
+}
+
+/*******************************************************************************************
+*	Function Name:			Runs
+*	Purpose:				the number of runs written, counting those merged in groups
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class T>
+int ExternalSorter<T>::Runs() const
+{
+	return written;
+}
+
+/*******************************************************************************************
+*	Function Name:			Failed
+*	Purpose:				tests whether a run file could not be written or read
+*	Input Parameters:		none
+*	Return value:			bool
+********************************************************************************************/
+template <class T>
+bool ExternalSorter<T>::Failed() const
+{
+	return failed;
+}
+
+/*******************************************************************************************
+*	Function Name:			Spill
+*	Purpose:				sorts the records held and writes them to a new run file
+*	Input Parameters:		none
+*	Return value:			bool	false if the run could not be written
+********************************************************************************************/
+template <class T>
+bool ExternalSorter<T>::Spill()
+{
+	std::sort(buffer.begin(), buffer.end());
+
+	std::string name = prefix + "." + std::to_string(written++);
+	std::ofstream out(name.c_str(), std::ios::binary | std::ios::trunc);
+	runs.push_back(name);
+	for (unsigned i = 0; i < buffer.size(); i++)
+		buffer[i].Write(out);
+	out.close();
+	failed = failed || out.fail();
+
+	buffer.clear();
+	used = 0;
+	return !failed;
+}
+
+/*******************************************************************************************
+*	Function Name:			Open
+*	Purpose:				opens runs for merging and puts the first record of each in
+*							the heap, keyed by the record with the run as its index
+*	Input Parameters:		const std::vector<std::string> &names	the run files
+*	Return value:			bool	false if a run could not be opened
+********************************************************************************************/
+template <class T>
+bool ExternalSorter<T>::Open(const std::vector<std::string> &names)
+{
+	CloseRuns();
+	heap.Reset(names.size());
+	for (unsigned i = 0; i < names.size(); i++)
+	{
+		readers.push_back(std::unique_ptr<std::ifstream>(new std::ifstream(names[i].c_str(), std::ios::binary)));
+		if (!*readers.back())
+			failed = true;
+
+		T record;
+		if (!failed && record.Read(*readers.back()))
+			heap.Push(i, record);
+	}
+	return !failed;
+}
+
+/*******************************************************************************************
+*	Function Name:			Pop
+*	Purpose:				takes the smallest record of the open runs and puts the next
+*							record of its run in its place
+*	Input Parameters:		T &record	receives the record
+*	Return value:			bool	false once the open runs are used up
+********************************************************************************************/
+template <class T>
+bool ExternalSorter<T>::Pop(T &record)
+{
+	if (heap.Empty())
+		return false;
+
+	int run = heap.Top();
+	record = heap.Key(run);
+	heap.Pop();
+
+	T following;
+	if (following.Read(*readers[run]))
+		heap.Push(run, following);
+	else if (readers[run]->bad())
+		failed = true;
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			CloseRuns
+*	Purpose:				closes the runs open for merging
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class T>
+void ExternalSorter<T>::CloseRuns()
+{
+	readers.clear();
+	heap.Clear();
+}
+
+#endif // !EXTERNALSORT_T
@@ -13,18 +13,57 @@
 *	Class Name:		Graph
 *
 *	Structs:
-*		edgeRep				a struct holding a vertex name and an edge weight
-*		vertex				a struct holding a name, if the vertex has been visited,
-*							a minimum distance, a previous vertex, and a listof edgeReps
+*		edgeRep				a struct holding a vertex name, an edge weight, and the index
+*							of the named vertex in the graph
+*		vertex				a struct holding a name, optional coordinates, and a list of
+*							edgeReps. The scratch state of the algorithms is kept in a
+*							Workspace per query (workspace.h), so the graph is only read
+*							while they run
+*		internedEdge		an edgeRep as the graph stores it, with the symbol of the
+*							vertex name in place of the name
+*		internedVertex		a vertex as the graph stores it, with the symbol of its name
+*							and a list of internedEdges. Names are taken in and handed out
+*							as strings; inside the graph only symbols are kept
+*		GraphLoadStats		the size of the last file LoadGraph read, what was in it, and
+*							how fast it was read
 *
 *	Private data members:
 *		bool populated		determines whether a graph has data in it or not
+*		StringTable names	every vertex name the graph has seen, each stored once, giving
+*							the symbols in G (stringtable.h)
+*		vector<int> vertexOf	the position in G of the vertex of each symbol, -1 if no
+*							vertex has that name, kept in sync by AddVertex, DeleteVertex,
+*							and GetGraph
+*		int danglingEdges	number of edges whose named vertex is not in the graph
+*		pending				the vertices with edges waiting on each name of no vertex, by
+*							symbol, so AddVertex resolves only the edges that name it
+*		unsigned revision	counts the changes made to the graph, so copies derived from it
+*							can tell when they are out of date
+*		reverse				the graph with every edge reversed, for the backward side of
+*							ShortestDistance, rebuilt when revision has moved past
+*							reverseRevision
+*		TreeCache trees		shortest path trees from earlier queries, told of each change
+*							to the graph so it keeps only the trees that are still right
+*		observers			the observers subscribed to the graph (dynamictree.h)
+*		lastLoad			the statistics of the last file read
 *
 *	Protected data members:
-*		vector<V> G			a vector of vertex structs, used to hold all of the vertices of the graph
+*		vector<Node> G		a vector of internedVertex structs, used to hold all of the vertices of the graph
 *
 *	Private member function:
-*		DFUtility			utility function for the recursion in the depth first traversal
+*		Intern				the symbol of a name, adding it to names if it is new
+*		RebuildIndex		rebuilds vertexOf after the positions in G have shifted
+*		ResolveEdges		stores the target vertex index in each edge of a vertex
+*		AddPending			lists a vertex under the names its unresolved edges wait on
+*		RebuildPending		rebuilds pending after the positions in G have shifted
+*		ParseVertices		reads vertices and their edges from a block of a graph file
+*		Reverse				the reversed graph, rebuilt first if the graph has changed
+*		PrintFordTree		prints the distances of a Ford tree, or its negative cycle
+*		NotifyEdgeAdded		moves to the next revision and tells the tree cache and the
+*		NotifyEdgeRemoved	observers of a change
+*		NotifyVertexAdded
+*		NotifyVertexRemoved
+*		NotifyReset
 *
 *	Public member functions:
 *		Graph				constructor for a Graph object
@@ -40,14 +79,35 @@
 *		DeleteBiDirEdge		removes an undirected edge between two vertices
 *		SimplyPrintGraph	prints the graph without a specific traversal
 *		ShortestDistance	finds the shortest distance between two vertices as well
-*							as the path between them (uses Dijkstra's algorithm)
-*		GetGraph			reads a graph in from a formatted file
+*							as the path between them (uses bidirectional Dijkstra, or A*
+*							when given a heuristic)
+*		VertexCount			the number of vertices, for the engines in search.h
+*		ForEachEdge			visits the target index and weight of each edge leaving a vertex
+*		ForEachEdgeUntil	visits the edges leaving a vertex until the visitor returns true
+*		Degree				the number of edges leaving a vertex
+*		Name				the name of a vertex index, for the visitors in visitor.h
+*		Location			the coordinates of a vertex index, for the heuristics in heuristic.h
+*		Freeze				makes a read-only compressed sparse row snapshot of the graph
+*		GetGraph			asks for a file name and reads the graph in from it
+*		LoadGraph			reads a graph in from a formatted file, on one thread or on
+*							the workers of a ThreadPool
+*		LastLoad			the size, counts, and read time of the last file read
+*		SaveBinary			writes the graph to a binary snapshot (mappedgraph.h)
+*		LoadBinary			reads the graph in from a binary snapshot
 *		BFTraversal			breadth first traversal of the graph
 *		DFTraversal			depth first traversal of the graph
 *		MST					Prim's algorithm for finding the minimum spanning tree of the graph
+*		SpanningTree		the edges and weight of a vertex's minimum spanning tree (Prim)
+*		SpanningForest		the edges and weight of the minimum spanning forest (Kruskal)
 *		FordShortestPath	finds the shortest path for all the vertices in the graph
 *							as well as the paths between them using Ford's algorithm to
 *							handle negative edge weights
+*		CachedFordShortestPath	prints the distances of a cached Ford tree without
+*							searching again
+*		Trees				the cache of shortest path trees, for its size and statistics
+*		SetTreeCacheLimit	changes the memory the cached trees may take
+*		Subscribe			tells an observer of every later change to the graph
+*		Unsubscribe			stops telling an observer of changes
 *
 ****************************************************************************************************/
 
@@ -57,32 +117,79 @@
 #include <list>
 #include <queue>
 #include <stack>
+#include <unordered_map>
+#include "search.h"
+#include "spanning.h"
+#include "landmarks.h"
+#include "treecache.h"
+#include "dynamictree.h"
+#include "mappedfile.h"
+#include "mappedgraph.h"
+#include "snapshotbuilder.h"
+#include "threadpool.h"
+#include "csrgraph.h"
+#include "stringtable.h"
 
 template <class V, class W> // V is the vertex class; W is edge weight class
 struct edgeRep
 {
+	typedef W weightType; // Type of the edge weight
 	V name;               // Vertex name
 	W weight;             // Edge weight
+	int target;           // Index of the named vertex in the graph, -1 if it is not in the graph
 };
 
 template <class V, class W>
 struct vertex           // Array cell structure for graph 
 {
 	typedef edgeRep<V, W> edge;
+	typedef V nameType;	  // Type of the vertex name, used to key the vertex index
 	V name;               // Vertex name
-	int visited;          // Used during traversal, Breadth-First or Depth-First
+	bool located = false; // Whether the graph file gave the vertex coordinates
+	double x = 0;         // First coordinate, the latitude for great-circle distances
+	double y = 0;         // Second coordinate, the longitude for great-circle distances
 	std::list<edge> edgelist; 	// Pointer to edge list
-	double minDist;		//minimum distance to source
-	double prevDist;	//minimum distance to previous vertex
-	V prev;				//name of the previous vertex
-	bool component;		//used during Prim's algorithm
 };
 
+template <class W>
+struct internedEdge		// edgeRep as the graph stores it
+{
+	int symbol;			// Symbol of the vertex name in the graph's string table
+	W weight;			// Edge weight
+	int target;			// Index of the named vertex in the graph, -1 if it is not in the graph
+};
+
+template <class W>
+struct internedVertex	// vertex as the graph stores it
+{
+	typedef internedEdge<W> edge;
+	int symbol = -1;		// Symbol of the vertex name in the graph's string table
+	bool located = false;	// Whether the graph file gave the vertex coordinates
+	double x = 0;			// First coordinate
+	double y = 0;			// Second coordinate
+	std::list<edge> edgelist;	// Edge list
+};
+
+struct GraphLoadStats
+{
+	std::size_t bytes = 0;		// Length of the file
+	int vertices = 0;			// Vertices read
+	long long edges = 0;		// Edges read
+	double seconds = 0;			// Time to map, scan, and index the file
+
+	// Megabytes read per second
+	double Throughput() const { return seconds > 0 ? bytes / seconds / 1e6 : 0; }
+};
+
+const std::size_t LOAD_CHUNK_BYTES = 1 << 20;	// Smallest piece of a file LoadGraph gives one worker
+
 template <class V, class W>
 class Graph
 {
 protected:
-	std::vector<V> G; // Main graph array for adjacency list representation
+	typedef internedVertex<typename W::weightType> Node;	// Vertex as G stores it
+	typedef typename Node::edge Arc;						// Edge as G stores it
+	std::vector<Node> G; // Main graph array for adjacency list representation
 
 						 //  protected member functions
 
@@ -130,21 +237,94 @@ public:
 	void SimplePrintGraph();
 	
 	//returns the shortest distance from vertex 1 to vertex 2
-	// use Dijkstra
+	// reads the path from the cached Dijkstra tree of vertex 1, O(path length), or
+	// searches from vertex 1 to every vertex and caches the tree, O((V + E) log V).
+	// With the cache turned off, or a graph too big for the cache to hold one tree
+	// (TreeCache::Fits), it uses Dijkstra from both ends at once, stopping once the
+	// path is proven; the first query after the graph changes then also rebuilds the
+	// reversed graph, O(V + E)
 	double ShortestDistance(V &v1, V &v2);
+
+	// ShortestDistance by A* with the given heuristic (heuristic.h), such as a
+	// GreatCircleHeuristic built from this graph once its coordinates are loaded,
+	// or Landmarks (landmarks.h) built from this graph and Freeze().Transpose().
+	// Prints the same information. O((V + E) log V), usually far less.
+	template <class Heuristic>
+	double ShortestDistance(V &v1, V &v2, const Heuristic &estimate);
+
+	// Number of vertices; vertex indices run from 0 to VertexCount() - 1
+	int VertexCount() const;
+
+	// Calls visit(target index, weight) for each edge leaving vertex index u
+	// whose target is in the graph. Used by the search engines in search.h.
+	template <class F>
+	void ForEachEdge(int u, F visit) const;
+
+	// Like ForEachEdge, but stops at the first edge for which visit returns true.
+	// Returns whether it stopped early.
+	template <class F>
+	bool ForEachEdgeUntil(int u, F visit) const;
+
+	// Number of edges leaving vertex index u
+	int Degree(int u) const;
+
+	// Name of vertex index u, copied out of the string table
+	typename V::nameType Name(int u) const;
+
+	// Sets x and y to the coordinates of vertex index u; returns false, leaving them
+	// alone, if the graph file gave none
+	bool Location(int u, double &x, double &y) const;
+
+	// Returns a read-only compressed sparse row copy of the graph for query-heavy
+	// workloads. Vertex indices in the snapshot match the indices in this graph.
+	CSRGraph<V, W> Freeze() const;
 	
 	// Retrieves a graph from a special file and sets up the adjacency
 	// list for the graph.  I am supplying 1 such files.The program
 	// will be able to read any graph that is in the same format:
 	// graph node followed by any adjacent nodes with followed by distance/wieigh 
 	// to the node.The adjacency entry is terminated by #
+	// A graph node may be followed by @ and two coordinates, as in
+	//     Atlanta @ 33.749 -84.388 Houston 650 Washington 600 #
+	// to give A* something to aim with (latitude and longitude for great-circle
+	// distances). Vertices without them load as before. Since # ends a vertex, no
+	// vertex may be named #; reading stops with an error at one that is.
 	void GetGraph();
+
+	// Reads a graph in the GetGraph format from the file at path without asking for
+	// anything, replacing the graph. The file is memory mapped and scanned in place,
+	// O(file size). Returns -1 if the file cannot be read, keeping the old graph, or if
+	// it ends in the middle of a vertex or names a vertex #, keeping the vertices read
+	// before; 1 otherwise.
+	int LoadGraph(const std::string &path);
+
+	// LoadGraph on the workers of pool. The file is cut into pieces just after a #,
+	// so each holds whole vertices, and the pieces are parsed at the same time; then
+	// the edge targets are resolved in parallel. Reads the same graph as LoadGraph;
+	// a vertex named # is rejected by both, as a cut could fall just after it.
+	int LoadGraph(const std::string &path, ThreadPool &pool);
+
+	// Size, vertex and edge counts, and time of the last file read by LoadGraph or LoadBinary
+	const GraphLoadStats &LastLoad() const;
+
+	// Writes the graph to a binary snapshot at path, to be queried in place by a
+	// MappedGraph or read back by LoadBinary. Edges to vertices not in the graph are
+	// left out. Returns -1 if the file cannot be written, 1 otherwise. O(V + E)
+	// A graph file too large to load can be made into a snapshot by a SnapshotBuilder.
+	int SaveBinary(const std::string &path) const;
+
+	// Reads a graph from a binary snapshot written by SaveBinary, replacing the graph,
+	// after checking its checksum. Nothing is parsed, but the lists are still built,
+	// O(V + E); to query a large graph without building anything, open the snapshot
+	// with a MappedGraph instead. Returns -1, keeping the old graph, if the file cannot
+	// be read, is not a snapshot, or is damaged; 1 otherwise.
+	int LoadBinary(const std::string &path);
 	
 	// Performs Breadth First Traversal with trace information printed 
 	void BFTraversal(V &v);
 	
-	//Performs a recursive Depth First Traversal of the graph starting at 
-	//specified vertex(parameter); prints trace information.
+	//Performs a Depth First Traversal of the graph starting at specified
+	//vertex(parameter) with an explicit stack; prints trace information.
 	void DFTraversal(V &v);
 	
 	// Determine the minimum spanning tree using Prim's algorithm.  
@@ -152,11 +332,82 @@ public:
 	// for each iteration. Weight of MST must be displayed. Also display whose connected to whom 
 	void MST(V &v);
 
+	// MST with the per-iteration trace replaced by visitor; its Settle hook is called
+	// each time a vertex joins the tree, and Finish once that vertex's edges have been
+	// relaxed. A NullVisitor gives a run without the trace.
+	template <class Visitor>
+	void MST(V &v, Visitor &visitor);
+
+	// Minimum spanning tree of the component of v using Prim's algorithm on an indexed
+	// min-heap, without printing. Fills tree with its edges and returns its weight, or
+	// -1 if v is not in the graph. O((V + E) log V)
+	double SpanningTree(V &v, std::vector<TreeEdge> &tree);
+
+	// Minimum spanning forest of the whole graph using Kruskal's algorithm with a
+	// union-find, without printing. Fills tree with its edges and returns its weight.
+	// O(E log E)
+	double SpanningForest(std::vector<TreeEdge> &tree);
+
 	// Determines the shortest paths to all other vertices from the specified vertex.
+	// Always searches, printing the queue trace, and caches the tree it finds.
 	void FordShortestPath(V &v1);
+
+	// Prints the distances from the cached Ford tree of the specified vertex without
+	// searching or tracing. Returns false, printing nothing, if there is none; call
+	// FordShortestPath then. O(V)
+	bool CachedFordShortestPath(V &v1);
+
+	// FordShortestPath with the queue trace replaced by visitor; Examine is called as
+	// a vertex is popped and Discover as one is queued. The distances, or the negative
+	// cycle that leaves them unbounded, are still printed. Always searches, and caches
+	// the tree it finds. O(VE)
+	template <class Visitor>
+	void FordShortestPath(V &v1, Visitor &visitor);
+
+	// The cache of shortest path trees behind ShortestDistance and FordShortestPath
+	const TreeCache &Trees() const;
+
+	// Changes the most bytes the cached trees may take; 0 turns the cache off
+	void SetTreeCacheLimit(std::size_t bytes);
+
+	// Tells observer of every later change to the graph, after it is made, such as
+	// a DynamicTree built from this graph. The observer must be unsubscribed before
+	// it is destroyed.
+	void Subscribe(GraphObserver &observer);
+
+	// Stops telling observer of changes to the graph
+	void Unsubscribe(GraphObserver &observer);
 private:
-	void DFUtility(V &v);
+	int Intern(const typename V::nameType &name);
+	void RebuildIndex();
+	int ResolveEdges(Node &vert);
+	void AddPending(int u);
+	void RebuildPending();
+	static bool ParseVertices(TokenScanner &scanner, std::vector<Node> &into, StringTable &symbols, long long &edges);
+	const CSRGraph<V, W> &Reverse();
+	void PrintFordTree(int source, const ShortestPathTree &tree);
+	void NotifyEdgeAdded(int from, int to, double weight);
+	void NotifyEdgeRemoved(int from, int to, double weight);
+	void NotifyVertexAdded();
+	void NotifyVertexRemoved(int v);
+	void NotifyReset();
 	bool populated;
+	int danglingEdges;
+	unsigned revision;
+	unsigned reverseRevision;
+	CSRGraph<V, W> reverse;
+	TreeCache trees;
+	std::vector<GraphObserver *> observers;
+	GraphLoadStats lastLoad;
+
+	// Each vertex name stored once; G holds the symbols it gives out
+	StringTable names;
+
+	// Maps the symbol of a vertex name to its index in G so lookups are O(1) on average
+	std::vector<int> vertexOf;
+
+	// Maps the symbol of a name no vertex has to the vertices with edges waiting on it
+	std::unordered_map<int, std::vector<int> > pending;
 };
 #include "graph.t"
 #endif // !GRAPH_H
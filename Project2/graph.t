@@ -19,6 +19,8 @@
 #include <string>
 #include <limits.h>
 #include <iomanip>
+#include <chrono>
+#include <algorithm>
 using namespace std;
 /*******************************************************************************************
 *	Function Name:			Graph()				the constructor
@@ -30,7 +32,11 @@ using namespace std;
 template <class V, class W>
 Graph<V, W>::Graph()
 {
+	static_assert(std::is_same<typename V::nameType, std::string>::value, "the string table stores vertex names as strings");
 	populated = false;
+	danglingEdges = 0;
+	revision = 1;
+	reverseRevision = 0;
 }
 
 /*******************************************************************************************
@@ -54,13 +60,233 @@ Graph<V, W>::~Graph()
 template <class V, class W>
 int Graph<V, W>::isVertex(V &v)
 {
+	//look the name up in the string table instead of scanning G; a name seen only on
+	//an edge, or left by a deleted vertex, has a symbol but no vertex
+	int symbol = names.Find(v.name);
+	if (symbol == -1)
+		return -1;
+	return vertexOf[symbol];
+}
+
+/*******************************************************************************************
+*	Function Name:			Intern
+*	Purpose:				the symbol of a vertex name, adding the name to the string table
+*							if it is new, with no vertex yet
+*	Input Parameters:		const nameType &name	the name
+*	Return value:			int		the symbol of the name
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::Intern(const typename V::nameType &name)
+{
+	int symbol = names.Intern(name);
+	if (symbol == (int)vertexOf.size())
+		vertexOf.push_back(-1);
+	return symbol;
+}
+
+/*******************************************************************************************
+*	Function Name:			RebuildIndex
+*	Purpose:				rebuilds the symbol to index map from G, used whenever the
+*							positions of the vertices in G have shifted
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::RebuildIndex()
+{
+	vertexOf.assign(names.Size(), -1);
+
+	//keep the first occurrence of a name, matching the old linear scan
+	for (unsigned i = 0; i < G.size(); i++)
+	{
+		if (vertexOf[G[i].symbol] == -1)
+			vertexOf[G[i].symbol] = i;
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			ResolveEdges
+*	Purpose:				stores the index in G of the vertex each edge of a vertex leads
+*							to, or -1 if no vertex with that name is in the graph
+*	Input Parameters:		Node &vert	the vertex whose edgelist is resolved
+*	Return value:			int		the number of edges left without a target
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::ResolveEdges(Node &vert)
+{
+	int unresolved = 0;
+	for (typename list<Arc>::iterator listIt = vert.edgelist.begin(); listIt != vert.edgelist.end(); listIt++)
+	{
+		listIt->target = vertexOf[listIt->symbol];
+		if (listIt->target == -1)
+			unresolved++;
+	}
+	return unresolved;
+}
+
+/*******************************************************************************************
+*	Function Name:			AddPending
+*	Purpose:				notes the edges of a vertex left without a target as waiting on
+*							the names they lead to
+*	Input Parameters:		int u	index of the vertex
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::AddPending(int u)
+{
+	for (typename list<Arc>::const_iterator listIt = (G[u].edgelist).begin(); listIt != (G[u].edgelist).end(); listIt++)
+	{
+		if (listIt->target != -1)
+			continue;
+
+		//a vertex is listed once under a name, however many of its edges wait on it
+		vector<int> &sources = pending[listIt->symbol];
+		if (sources.empty() || sources.back() != u)
+			sources.push_back(u);
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			RebuildPending
+*	Purpose:				rebuilds the map of the edges waiting on each name from G, used
+*							whenever the positions in G have shifted or G was read in whole
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::RebuildPending()
+{
+	pending.clear();
+	for (unsigned u = 0; u < G.size() && danglingEdges > 0; u++)
+		AddPending(u);
+}
 
-	for (typename vector<V>::iterator vectIt = G.begin(); vectIt != G.end(); vectIt++)
+/*******************************************************************************************
+*	Function Name:			Reverse
+*	Purpose:				the graph with every edge reversed. The copy is rebuilt from a
+*							snapshot of the graph when the graph has changed since it was
+*							last built, so a run of queries without changes builds it once.
+*	Input Parameters:		none
+*	Return value:			const CSRGraph<V, W> &
+********************************************************************************************/
+template <class V, class W>
+const CSRGraph<V, W> &Graph<V, W>::Reverse()
+{
+	if (reverseRevision != revision)
 	{
-		if (vectIt->name == v.name)
-			return (distance(G.begin(), vectIt));
+		reverse = Freeze().Transpose();
+		reverseRevision = revision;
 	}
-	return -1;
+	return reverse;
+}
+
+/*******************************************************************************************
+*	Function Name:			NotifyEdgeAdded
+*	Purpose:				moves to the next revision after an edge is added and tells the
+*							tree cache and the observers
+*	Input Parameters:		int from		index of the start of the edge
+*							int to			index of the end of the edge
+*							double weight	the weight of the edge
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::NotifyEdgeAdded(int from, int to, double weight)
+{
+	revision++;
+	trees.EdgeAdded(from, to, weight, revision);
+	for (unsigned i = 0; i < observers.size(); i++)
+		observers[i]->EdgeAdded(from, to, weight);
+}
+
+/*******************************************************************************************
+*	Function Name:			NotifyEdgeRemoved
+*	Purpose:				moves to the next revision after an edge is removed and tells
+*							the tree cache and the observers
+*	Input Parameters:		int from		index of the start of the edge
+*							int to			index of the end of the edge
+*							double weight	the weight of the edge
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::NotifyEdgeRemoved(int from, int to, double weight)
+{
+	revision++;
+	trees.EdgeRemoved(from, to, revision);
+	for (unsigned i = 0; i < observers.size(); i++)
+		observers[i]->EdgeRemoved(from, to, weight);
+}
+
+/*******************************************************************************************
+*	Function Name:			NotifyVertexAdded
+*	Purpose:				moves to the next revision after a vertex with no edges is added
+*							and tells the tree cache and the observers
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::NotifyVertexAdded()
+{
+	revision++;
+	trees.VertexAdded(revision);
+	for (unsigned i = 0; i < observers.size(); i++)
+		observers[i]->VertexAdded();
+}
+
+/*******************************************************************************************
+*	Function Name:			NotifyVertexRemoved
+*	Purpose:				moves to the next revision after a vertex is removed, dropping
+*							the cached trees whose indices no longer match, and tells the
+*							observers
+*	Input Parameters:		int v	the index the removed vertex had
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::NotifyVertexRemoved(int v)
+{
+	revision++;
+	trees.Clear();
+	for (unsigned i = 0; i < observers.size(); i++)
+		observers[i]->VertexRemoved(v);
+}
+
+/*******************************************************************************************
+*	Function Name:			NotifyReset
+*	Purpose:				moves to the next revision after a change not made edge by edge,
+*							dropping the cached trees, and tells the observers
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::NotifyReset()
+{
+	revision++;
+	trees.Clear();
+	for (unsigned i = 0; i < observers.size(); i++)
+		observers[i]->Reset();
+}
+
+/*******************************************************************************************
+*	Function Name:			Subscribe
+*	Purpose:				adds an observer to be told of every later change to the graph
+*	Input Parameters:		GraphObserver &observer		the observer
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::Subscribe(GraphObserver &observer)
+{
+	observers.push_back(&observer);
+}
+
+/*******************************************************************************************
+*	Function Name:			Unsubscribe
+*	Purpose:				stops telling an observer of changes to the graph
+*	Input Parameters:		GraphObserver &observer		the observer
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::Unsubscribe(GraphObserver &observer)
+{
+	observers.erase(std::remove(observers.begin(), observers.end(), &observer), observers.end());
 }
 
 /*******************************************************************************************
@@ -77,22 +303,22 @@ int Graph<V, W>::isUniEdge(V &v1, V &v2)
 	int v2Index = isVertex(v2);
 	int firstFound = 0;
 	int secondFound = 0;
-	if (v1Index == -1 || v1Index == -1)
+	if (v1Index == -1 || v2Index == -1)
 		return -1;
 
 	//finds one edge
-	for (typename list<W>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
 	{
 
-		if (listIt->name == v1.name)
+		if (listIt->target == v1Index)
 			firstFound = 1;
 	}
 
 	//finds the other edge
-	for (typename list<W>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
 	{
 
-		if (listIt->name == v2.name)
+		if (listIt->target == v2Index)
 			secondFound = 1;
 	}
 
@@ -121,18 +347,18 @@ int Graph<V, W>::isBiDirEdge(V &v1, V &v2)
 		return -1;
 
 	//finds one edge
-	for (typename list<W>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
 	{
 
-		if (listIt->name == v1.name)
+		if (listIt->target == v1Index)
 			firstFound = 1;
 	}
 
 	//finds the other edge
-	for (typename list<W>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
 	{
 
-		if (listIt->name == v2.name)
+		if (listIt->target == v2Index)
 			secondFound = 1;
 	}
 
@@ -158,7 +384,70 @@ int Graph<V, W>::AddVertex(V &v)
 		return -1;
 	}
 	else
-		G.push_back(v);
+	{
+		//store the vertex and the edges it came with by the symbols of their names
+		Node vert;
+		vert.symbol = Intern(v.name);
+		vert.located = v.located;
+		vert.x = v.x;
+		vert.y = v.y;
+		for (typename list<W>::const_iterator listIt = v.edgelist.begin(); listIt != v.edgelist.end(); listIt++)
+		{
+			Arc edge;
+			edge.symbol = Intern(listIt->name);
+			edge.weight = listIt->weight;
+			edge.target = -1;
+			vert.edgelist.push_back(edge);
+		}
+		vertexOf[vert.symbol] = G.size();
+		G.push_back(std::move(vert));
+
+		//resolve the targets of any edges the new vertex came with
+		int vIndex = G.size() - 1;
+		int unresolved = ResolveEdges(G.back());
+
+		//edges that were waiting on a vertex with this name can now be resolved; only
+		//the vertices listed under the name are looked at, not the whole graph
+		bool resolved = false;
+		typename unordered_map<int, vector<int> >::iterator found = pending.find(G[vIndex].symbol);
+		if (found != pending.end())
+		{
+			for (unsigned i = 0; i < found->second.size(); i++)
+			{
+				Node &source = G[found->second[i]];
+				for (typename list<Arc>::iterator listIt = source.edgelist.begin(); listIt != source.edgelist.end(); listIt++)
+				{
+					if (listIt->target == -1 && listIt->symbol == G[vIndex].symbol)
+					{
+						listIt->target = vIndex;
+						danglingEdges--;
+						resolved = true;
+					}
+				}
+			}
+			pending.erase(found);
+		}
+
+		//the new vertex's own edges to names of no vertex wait in turn
+		danglingEdges += unresolved;
+		if (unresolved > 0)
+			AddPending(vIndex);
+
+		//edges that now lead to the new vertex may shorten paths through it, so every
+		//tree is rebuilt. Otherwise nothing reaches the new vertex, so it joins every tree
+		//unreachable and its own edges, told of one by one, cannot shorten any path.
+		if (resolved)
+			NotifyReset();
+		else
+		{
+			NotifyVertexAdded();
+			for (typename list<Arc>::const_iterator listIt = (G[vIndex].edgelist).begin(); listIt != (G[vIndex].edgelist).end(); listIt++)
+			{
+				if (listIt->target != -1)
+					NotifyEdgeAdded(vIndex, listIt->target, listIt->weight);
+			}
+		}
+	}
 
 	//if nothing in graph
 	if (!populated)
@@ -185,21 +474,44 @@ int Graph<V, W>::DeleteVertex(V& v)
 		return -1;
 	}
 
-	//delete vertex
+	//the deleted vertex's own unresolved edges go away with it
+	for (typename list<Arc>::const_iterator listIt = (G[vIndex].edgelist).begin(); listIt != (G[vIndex].edgelist).end(); listIt++)
+	{
+		if (listIt->target == -1)
+			danglingEdges--;
+	}
+
+	//delete vertex, every vertex after it shifts down one position
 	G.erase(G.begin() + vIndex);
+	RebuildIndex();
 
 	//delete incident edges
 	for (unsigned i = 0; i < G.size(); i++)
 	{
-		for (typename list<W>::const_iterator listIt = (G[i].edgelist).begin(); listIt != (G[i].edgelist).end(); listIt++)
+		for (typename list<Arc>::const_iterator listIt = (G[i].edgelist).begin(); listIt != (G[i].edgelist).end(); listIt++)
 		{
-			if (listIt->name == v.name)
+			if (listIt->target == vIndex)
 			{
 				G[i].edgelist.erase(listIt);
 				break;
 			}
 		}
+
+		//shift the stored targets to match the new positions in G
+		for (typename list<Arc>::iterator listIt = (G[i].edgelist).begin(); listIt != (G[i].edgelist).end(); listIt++)
+		{
+			if (listIt->target == vIndex)
+			{
+				//a duplicate edge to the deleted vertex no longer has a target
+				listIt->target = -1;
+				danglingEdges++;
+			}
+			else if (listIt->target > vIndex)
+				listIt->target--;
+		}
 	}
+	RebuildPending();
+	NotifyVertexRemoved(vIndex);
 	return 0;
 }
 
@@ -246,7 +558,10 @@ int Graph<V, W>::AddUniEdge(V &v1, V &v2, W &wt)
 
 	//add the edge
 	wt.name = v2.name;
-	G[v1Index].edgelist.push_back(wt);
+	wt.target = v2Index;
+	Arc edge = { G[v2Index].symbol, wt.weight, v2Index };
+	G[v1Index].edgelist.push_back(edge);
+	NotifyEdgeAdded(v1Index, v2Index, wt.weight);
 	return 1;
 
 }
@@ -293,22 +608,26 @@ int Graph<V, W>::DeleteUniEdge(V &v1, V &v2)
 	}
 
 	//if the edge is in v2, delete it
-	for (typename list<W>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
 	{
-		if (listIt->name == v1.name)
+		if (listIt->target == v1Index)
 		{
+			double weight = listIt->weight;
 			G[v2Index].edgelist.erase(listIt);
+			NotifyEdgeRemoved(v2Index, v1Index, weight);
 			return 1;
 		}
 
 	}
 
 	//if the edge is in v1, delete it
-	for (typename list<W>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
 	{
-		if (listIt->name == v2.name)
+		if (listIt->target == v2Index)
 		{
+			double weight = listIt->weight;
 			G[v1Index].edgelist.erase(listIt);
+			NotifyEdgeRemoved(v1Index, v2Index, weight);
 			return 1;
 		}
 
@@ -358,10 +677,16 @@ int Graph<V, W>::AddBiDirEdge(V &v1, V &v2, W &wt)
 	}
 
 	wt.name = v2.name;
-	G[v1Index].edgelist.push_back(wt);
+	wt.target = v2Index;
+	Arc forward = { G[v2Index].symbol, wt.weight, v2Index };
+	G[v1Index].edgelist.push_back(forward);
+	NotifyEdgeAdded(v1Index, v2Index, wt.weight);
 
 	wt.name = v1.name;
-	G[v2Index].edgelist.push_back(wt);
+	wt.target = v1Index;
+	Arc backward = { G[v1Index].symbol, wt.weight, v1Index };
+	G[v2Index].edgelist.push_back(backward);
+	NotifyEdgeAdded(v2Index, v1Index, wt.weight);
 	return 1;
 	//add edges going both directions
 	/*if (AddUniEdge(v1, v2, wt) && AddUniEdge(v2, v1, wt))
@@ -386,13 +711,13 @@ int Graph<V, W>::DeleteBiDirEdge(V &v1, V &v2)
 	//if vertices not in graph, return
 	if (v1Index == -1)
 	{
-		cout << "\n\nVertex " << G[v1Index].name << " not found." << endl;
+		cout << "\n\nVertex " << v1.name << " not found." << endl;
 		return -1;
 	}
 
 	if (v2Index == -1)
 	{
-		cout << "\n\nVertex " << G[v2Index].name << " not found." << endl;
+		cout << "\n\nVertex " << v2.name << " not found." << endl;
 		return -1;
 	}
 
@@ -411,22 +736,26 @@ int Graph<V, W>::DeleteBiDirEdge(V &v1, V &v2)
 	}
 
 	//delete from v2
-	for (typename list<W>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v2Index].edgelist).begin(); listIt != (G[v2Index].edgelist).end(); listIt++)
 	{
-		if (listIt->name == v1.name)
+		if (listIt->target == v1Index)
 		{
+			double weight = listIt->weight;
 			G[v2Index].edgelist.erase(listIt);
+			NotifyEdgeRemoved(v2Index, v1Index, weight);
 			break;
 		}
 
 	}
 
 	//delete from v1
-	for (typename list<W>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
+	for (typename list<Arc>::const_iterator listIt = (G[v1Index].edgelist).begin(); listIt != (G[v1Index].edgelist).end(); listIt++)
 	{
-		if (listIt->name == v2.name)
+		if (listIt->target == v2Index)
 		{
+			double weight = listIt->weight;
 			G[v1Index].edgelist.erase(listIt);
+			NotifyEdgeRemoved(v1Index, v2Index, weight);
 			break;
 		}
 
@@ -448,16 +777,16 @@ void Graph<V, W>::SimplePrintGraph()
 	for (unsigned i = 0; i < G.size(); i++)
 	{
 		//print each vertex
-		cout << "\n\nVertex: " << G[i].name << endl;
+		cout << "\n\nVertex: " << Name(i) << endl;
 
 		//if the vertex has no edges, continue
 		if (G[i].edgelist.empty())
 			cout << "\twith no edges." << endl;
 
 		//otherwise print the edgelist
-		for (typename list<W>::const_iterator listIt = (G[i].edgelist).begin(); listIt != (G[i].edgelist).end(); listIt++)
+		for (typename list<Arc>::const_iterator listIt = (G[i].edgelist).begin(); listIt != (G[i].edgelist).end(); listIt++)
 		{
-			cout << "\t->(" << listIt->name << " with weight " << listIt->weight << ")" << endl;
+			cout << "\t->(" << names.Name(listIt->symbol) << " with weight " << listIt->weight << ")" << endl;
 		}
 		cout << endl;
 	}
@@ -466,7 +795,12 @@ void Graph<V, W>::SimplePrintGraph()
 /*******************************************************************************************
 *	Function Name:			ShortestDistance
 *	Purpose:				Calculates the shortest distance between two vertexes using
-*							Dijkstra's algorithm and finds the optimal path between them
+*							Dijkstra's algorithm and finds the optimal path between them.
+*							The whole shortest path tree of v1 is kept in the tree cache, so
+*							a later query from v1 only walks back along its path. With the
+*							cache off, or a graph whose tree is too big to cache, Dijkstra
+*							runs from both ends at once instead and stops once the path is
+*							proven.
 *	Input Parameters:		V &v1	the starting vertex
 *							V &v2	the ending vertex
 *	Return value:			double	the shortest path from v1 to v2
@@ -475,320 +809,642 @@ template <class V, class W>
 double Graph<V, W>::ShortestDistance(V &v1, V &v2)
 {
 	cout << "Calculating the shortest path using Dijkstra's Algorithm." << endl;
-	queue<V> q;			//queue used during the calculation
-	stack<V> path;		//stack for holding the optimal path
+	Workspace forward;		//distances and previous vertices of the search from v1
+	Workspace backward;		//distances and next vertices of the search from v2
+	ShortestPathTree fresh;	//the tree of v1 when it is not cached
+	vector<int> path;		//the optimal path
+	double minDist;
 
 	bool arrow = false;		//used for print formatting
 	int v1Index = isVertex(v1);
 	int v2Index = isVertex(v2);
 
-	//set minimum distances to infinity, visited to 0, and prev to nothing
-	for (unsigned i = 0; i < G.size(); i++)
+	if (v1Index == -1 || v2Index == -1)
 	{
-		G[i].minDist = INT_MAX;
-		G[i].visited = 0;
-		G[i].prev = "";
+		cout << "\n\nNo path from " << v1.name << " to " << v2.name << " found." << endl;
+		return -1;
 	}
 
-	//set starting vertex minimum distance to 0
-	G[v1Index].minDist = 0;
-
-	//push start into queue
-	q.push(v1);
-
-	while (!q.empty())
+	if (!trees.Fits(G.size()))
 	{
-		//current vertex to consider
-		V curr;
-		curr = q.front();
-
-		//remove from queue
-		q.pop();
-		int currIndex = isVertex(curr);
-
-		//mark current as visited
-		G[currIndex].visited = 1;
-
-		//look through edgelist
-		for (typename list<W>::const_iterator listIt = (G[currIndex].edgelist).begin(); listIt != (G[currIndex].edgelist).end(); listIt++)
+		//the whole tree would not be kept, so search forward from v1 and backward from
+		//v2 only until they prove the shortest path
+		minDist = BidirectionalSearch(*this, Reverse(), v1Index, v2Index, path, forward, backward);
+	}
+	else
+	{
+		//use the tree of v1, searching from v1 to every vertex if it is not cached
+		const ShortestPathTree *tree = trees.Find(DIJKSTRA_TREE, v1Index, revision);
+		if (tree == NULL)
 		{
-			//look through the vertices
-			for (unsigned i = 0; i < G.size(); i++)
-			{
-				//if a vertex is in the edgelist
-				if (listIt->name == G[i].name)
-				{
-					//get the weight
-					int cost = listIt->weight;
-
-					//if the minimum distance plus the weight is less than the minimum distance to the vertices in the edgelist
-					if (G[currIndex].minDist + cost < G[i].minDist)
-					{
-						//push into queue
-						q.push(G[i]);
-
-						//set the new minimum distance to the first vertex plus the weight
-						G[i].minDist = G[currIndex].minDist + cost;
+			DijkstraSearch(*this, v1Index, -1, forward);
+			fresh.Assign(forward);
+			trees.Insert(DIJKSTRA_TREE, v1Index, fresh, revision);
+			tree = &fresh;
+		}
 
-						//the previous node is now the node just considered
-						G[i].prev = G[currIndex].name;
-					}
-				}
-			}
+		//look back at each vertex's previous vertex, from v2 to v1
+		minDist = tree->dist[v2Index];
+		if (minDist != UNREACHABLE)
+		{
+			for (int at = v2Index; at != -1; at = tree->prev[at])
+				path.push_back(at);
+			std::reverse(path.begin(), path.end());
 		}
 	}
 
 	//if the minimum distance is still infinity, no path exists
-	if (G[v2Index].minDist == INT_MAX)
+	if (minDist == UNREACHABLE)
 	{
 		cout << "\n\nNo path from " << v1.name << " to " << v2.name << " found." << endl;
 		return -1;
 	}
-	
-	//printing the path
-	V temp;
-
-	//find the previous vertex from the final vertex
-	temp.name = G[v2Index].prev;
-	temp = G[isVertex(temp)];
-
-	//push the final vertex onto the stack
-	path.push(v2);
-
-	//look back at each vertex's previous vertex
-	while (temp.prev != "")
-	{
-		//push previous onto the stack
-		path.push(G[isVertex(temp)]);
-
-		//update the temp to be the next previous
-		temp.name = temp.prev;
-		temp = G[isVertex(temp)];
-	}
-
-	//push the origin vertex onto the stack
-	path.push(v1);
 
 	cout << "\n\nThe shortest path from " << v1.name << " to " << v2.name << " is: " << endl;
 
-	//pop the stack to get the path from the origin to the final vertex
-	while (!path.empty())
+	//print the path from the origin to the final vertex
+	for (unsigned i = 0; i < path.size(); i++)
 	{
 		if (!arrow)
 		{
-			cout << "(" << path.top().name << ")" << endl;
+			cout << "(" << Name(path[i]) << ")" << endl;
 			arrow = true;
 		}
 		else
-			cout << "\t->(" << path.top().name << ")" << endl;
-		path.pop();
+			cout << "\t->(" << Name(path[i]) << ")" << endl;
 	}
 
-	return G[v2Index].minDist;
+	return minDist;
 }
 
 /*******************************************************************************************
-*	Function Name:			GetGraph
-*	Purpose:				reads in a graph from a formatted file
-*	Input Parameters:		none
-*	Return value:			void
+*	Function Name:			ShortestDistance
+*	Purpose:				Calculates the shortest distance between two vertexes using
+*							A* with a heuristic and finds the optimal path between them
+*	Input Parameters:		V &v1						the starting vertex
+*							V &v2						the ending vertex
+*							const Heuristic &estimate	lower bound on the distance to v2
+*	Return value:			double	the shortest path from v1 to v2
 ********************************************************************************************/
 template <class V, class W>
-void Graph<V, W>::GetGraph()
+template <class Heuristic>
+double Graph<V, W>::ShortestDistance(V &v1, V &v2, const Heuristic &estimate)
 {
-	//if the graph has data in it, delete the data
-	if (populated)
-	{
-		for (unsigned i = 0; i < G.size(); i++)
-		{
-			G[i].edgelist.erase(G[i].edgelist.begin(), G[i].edgelist.end());
+	cout << "Calculating the shortest path using A*." << endl;
+	Workspace ws;			//distances and previous vertices for this search
+	vector<int> path;		//the optimal path
 
-		}
-		G.erase(G.begin(), G.end());
-	}
+	bool arrow = false;		//used for print formatting
+	int v1Index = isVertex(v1);
+	int v2Index = isVertex(v2);
 
-	//get the filename
-	string filename;
-	cout << "Enter the filename of the graph:" << endl;
-	cin >> filename;
-	ifstream inFile;
-	inFile.open(filename);
-	if (!inFile)
+	if (v1Index == -1 || v2Index == -1)
 	{
-		cout << "\n\nError opening " << filename << endl;
-		return;
+		cout << "\n\nNo path from " << v1.name << " to " << v2.name << " found." << endl;
+		return -1;
 	}
 
-	//read the data
-	V vert;
-	W edge;
-	int i = 0;
+	//search from v1, aiming at v2
+	double minDist = AStarSearch(*this, v1Index, v2Index, ws, estimate);
 
-	//read the vertices
-	inFile >> vert.name;
-	while (inFile)
+	//if the minimum distance is still infinity, no path exists
+	if (minDist == UNREACHABLE)
 	{
-		vert.visited = 0;
+		cout << "\n\nNo path from " << v1.name << " to " << v2.name << " found." << endl;
+		return -1;
+	}
 
-		//push into the vector
-		G.push_back(vert);
+	//look back at each vertex's previous vertex, from v2 to v1
+	for (int at = v2Index; at != -1; at = ws.Prev(at))
+		path.push_back(at);
 
-		//read the edges
-		inFile >> edge.name;
+	cout << "\n\nThe shortest path from " << v1.name << " to " << v2.name << " is: " << endl;
 
-		while (edge.name != "#")
+	//print the path from the origin to the final vertex
+	for (int i = path.size() - 1; i >= 0; i--)
+	{
+		if (!arrow)
 		{
-			//read the weights and push into the list of the appropriate vertex
-			inFile >> edge.weight;
-			G[i].edgelist.push_back(edge);
-			inFile >> edge.name;
+			cout << "(" << Name(path[i]) << ")" << endl;
+			arrow = true;
 		}
-		i++;
-		inFile >> vert.name;
+		else
+			cout << "\t->(" << Name(path[i]) << ")" << endl;
 	}
 
-	inFile.close();
-	cout << "\n\nGraph populated." << endl;
-	populated = true;
+	return minDist;
+}
 
+/*******************************************************************************************
+*	Function Name:			VertexCount
+*	Purpose:				the number of vertices in the graph
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::VertexCount() const
+{
+	return G.size();
 }
 
 /*******************************************************************************************
-*	Function Name:			Breadth First Traversal
-*	Purpose:				breadth first traversal of a graph
-*	Input Parameters:		V &v	the starting vertex
+*	Function Name:			ForEachEdge
+*	Purpose:				calls visit with the target index and weight of each edge
+*							leaving a vertex, skipping edges to vertices not in the graph
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight)
 *	Return value:			void
 ********************************************************************************************/
 template <class V, class W>
-void Graph<V, W>::BFTraversal(V &v)
+template <class F>
+void Graph<V, W>::ForEachEdge(int u, F visit) const
 {
-	V curr;				//current vertex
-	queue<V> q;			//queue used for the traversal
-	bool arrow = false;	//used for print formatting
-
-	//if vertex is not in the graph
-	int vIndex = isVertex(v);
-	if (vIndex == -1)
+	for (typename list<Arc>::const_iterator listIt = (G[u].edgelist).begin(); listIt != (G[u].edgelist).end(); listIt++)
 	{
-		cout << "\n\nVertex " << G[vIndex].name << " not found." << endl;
-		return;
+		if (listIt->target != -1)
+			visit(listIt->target, listIt->weight);
 	}
+}
 
-	//set all of the vertexes to unvisited
-	for (unsigned i = 0; i < G.size(); i++)
+/*******************************************************************************************
+*	Function Name:			ForEachEdgeUntil
+*	Purpose:				calls visit with the target index and weight of each edge
+*							leaving a vertex until visit returns true
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight), returning bool
+*	Return value:			bool	true if visit returned true for some edge
+********************************************************************************************/
+template <class V, class W>
+template <class F>
+bool Graph<V, W>::ForEachEdgeUntil(int u, F visit) const
+{
+	for (typename list<Arc>::const_iterator listIt = (G[u].edgelist).begin(); listIt != (G[u].edgelist).end(); listIt++)
 	{
-		G[i].visited = 0;
-
-		//set the current vertex to visited
-		if (G[i].name == v.name)
-		{
-			curr = G[i];
-			G[i].visited = 1;
-		}
+		if (listIt->target != -1 && visit(listIt->target, listIt->weight))
+			return true;
 	}
+	return false;
+}
 
-	curr.visited = 1;
+/*******************************************************************************************
+*	Function Name:			Degree
+*	Purpose:				the number of edges leaving a vertex
+*	Input Parameters:		int u	index of the vertex
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::Degree(int u) const
+{
+	return G[u].edgelist.size();
+}
 
-	//push start into the queue
-	q.push(curr);
+/*******************************************************************************************
+*	Function Name:			Name
+*	Purpose:				the name of a vertex, copied out of the string table
+*	Input Parameters:		int u	index of the vertex
+*	Return value:			nameType
+********************************************************************************************/
+template <class V, class W>
+typename V::nameType Graph<V, W>::Name(int u) const
+{
+	return names.Name(G[u].symbol);
+}
 
-	while (!q.empty())
-	{
-		curr = q.front();
+/*******************************************************************************************
+*	Function Name:			Location
+*	Purpose:				the coordinates of a vertex
+*	Input Parameters:		int u		index of the vertex
+*							double &x	set to the first coordinate
+*							double &y	set to the second coordinate
+*	Return value:			bool	false if the vertex has no coordinates
+********************************************************************************************/
+template <class V, class W>
+bool Graph<V, W>::Location(int u, double &x, double &y) const
+{
+	if (!G[u].located)
+		return false;
+	x = G[u].x;
+	y = G[u].y;
+	return true;
+}
 
-		//print the traversal
-		if (!arrow)
+/*******************************************************************************************
+*	Function Name:			Freeze
+*	Purpose:				copies the graph into a compressed sparse row snapshot, with the
+*							edges of each vertex stored contiguously in edgelist order.
+*							Edges to vertices not in the graph are left out.
+*	Input Parameters:		none
+*	Return value:			CSRGraph<V, W>	the snapshot
+********************************************************************************************/
+template <class V, class W>
+CSRGraph<V, W> Graph<V, W>::Freeze() const
+{
+	CSRGraph<V, W> snapshot;
+	unsigned edgeCount = 0;
+
+	//size the arrays first so they are allocated once
+	for (unsigned i = 0; i < G.size(); i++)
+		edgeCount += G[i].edgelist.size();
+	snapshot.names.reserve(G.size());
+	snapshot.offsets.reserve(G.size() + 1);
+	snapshot.targets.reserve(edgeCount);
+	snapshot.weights.reserve(edgeCount);
+	snapshot.vertexIndex.reserve(G.size());
+
+	//lay each edgelist out after the previous one
+	for (unsigned i = 0; i < G.size(); i++)
+	{
+		snapshot.names.push_back(Name(i));
+		snapshot.vertexIndex.emplace(snapshot.names.back(), i);
+		for (typename list<Arc>::const_iterator listIt = (G[i].edgelist).begin(); listIt != (G[i].edgelist).end(); listIt++)
 		{
-			cout << "(" << curr.name << ")" << endl;
-			arrow = true;
+			if (listIt->target == -1)
+				continue;
+			snapshot.targets.push_back(listIt->target);
+			snapshot.weights.push_back(listIt->weight);
 		}
-		else
-			cout << "\t->(" << curr.name << ")" << endl;
+		snapshot.offsets.push_back(snapshot.targets.size());
+	}
 
+	return snapshot;
+}
 
-		q.pop();
+/*******************************************************************************************
+*	Function Name:			GetGraph
+*	Purpose:				asks for the filename of a graph and reads it in with LoadGraph,
+*							on one worker per hardware thread
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::GetGraph()
+{
+	//get the filename
+	string filename;
+	cout << "Enter the filename of the graph:" << endl;
+	cin >> filename;
+	ThreadPool pool;
+	LoadGraph(filename, pool);
+}
+
+/*******************************************************************************************
+*	Function Name:			LoadGraph
+*	Purpose:				reads in a graph from a formatted file on the calling thread
+*	Input Parameters:		const string &path	the file to read
+*	Return value:			int		-1 if the file cannot be read or ends in the middle of a
+*									vertex, 1 otherwise
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::LoadGraph(const string &path)
+{
+	ThreadPool pool(1);
+	return LoadGraph(path, pool);
+}
 
-		//look through the edgelists
-		for (typename list<W>::const_iterator listIt = curr.edgelist.begin(); listIt != curr.edgelist.end(); listIt++)
+/*******************************************************************************************
+*	Function Name:			LoadGraph
+*	Purpose:				reads in a graph from a formatted file. The file is mapped into
+*							memory and cut into pieces, each ending just after a #, which
+*							the workers split into tokens in place and parse into vertices
+*							of their own. The pieces are moved into G in file order, and
+*							the targets are resolved once every vertex is known. A piece
+*							that ends in the middle of a vertex stops the read there, as
+*							if the pieces had been read one after another.
+*	Input Parameters:		const string &path	the file to read
+*							ThreadPool &pool	the workers to parse with
+*	Return value:			int		-1 if the file cannot be read or ends in the middle of a
+*									vertex, 1 otherwise
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::LoadGraph(const string &path, ThreadPool &pool)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	MappedFile file;
+	if (!file.Open(path))
+	{
+		cout << "\n\nError opening " << path << endl;
+		return -1;
+	}
+
+	//if the graph has data in it, delete the data; the observers are told once the
+	//new graph is built, so they never see it empty
+	if (populated)
+	{
+		G.clear();
+		names.Clear();
+		vertexOf.clear();
+		pending.clear();
+		danglingEdges = 0;
+	}
+
+	//cut the file into a few pieces per worker, but none much under LOAD_CHUNK_BYTES
+	const char *begin = file.Data();
+	const char *end = begin + file.Size();
+	int pieces = pool.Size() == 1 ? 1 : pool.Size() * 4;
+	if ((size_t)pieces > file.Size() / LOAD_CHUNK_BYTES + 1)
+		pieces = file.Size() / LOAD_CHUNK_BYTES + 1;
+	vector<const char *> cuts(pieces + 1, end);
+	cuts[0] = begin;
+	for (int i = 1; i < pieces; i++)
+	{
+		TokenScanner scanner(max(begin + file.Size() / pieces * i, cuts[i - 1]), end);
+		scanner.SkipPast("#");
+		cuts[i] = scanner.Position();
+	}
+
+	//parse the pieces at the same time, each into its own vertices; the first piece
+	//interns its names straight into names, the others into tables of their own
+	vector<vector<Node> > parsed(pieces);
+	vector<StringTable> symbols(pieces - 1);
+	vector<long long> edgeCounts(pieces, 0);
+	vector<char> completed(pieces, 1);
+	pool.ParallelFor(pieces, 1, [&](int, int i)
+	{
+		TokenScanner scanner(cuts[i], cuts[i + 1]);
+		parsed[i].reserve(scanner.Count("#"));
+		completed[i] = ParseVertices(scanner, parsed[i], i == 0 ? names : symbols[i - 1], edgeCounts[i]);
+	});
+
+	//keep the pieces up to and including the first one that did not finish
+	int kept = 0;
+	while (kept < pieces && completed[kept])
+		kept++;
+	bool complete = kept == pieces;
+	if (!complete)
+		kept++;
+
+	//move the vertices of each piece into place in G
+	vector<size_t> offsets(kept + 1, G.size());
+	long long edges = 0;
+	for (int i = 0; i < kept; i++)
+	{
+		offsets[i + 1] = offsets[i] + parsed[i].size();
+		edges += edgeCounts[i];
+	}
+	//give the names of the other pieces their symbols in names, in file order
+	vector<vector<int> > remap(kept);
+	for (int i = 1; i < kept; i++)
+	{
+		remap[i].resize(symbols[i - 1].Size());
+		for (int s = 0; s < symbols[i - 1].Size(); s++)
+			remap[i][s] = names.Intern(symbols[i - 1].Data(s), symbols[i - 1].Length(s));
+		symbols[i - 1].Clear();
+	}
+
+	//change each piece over to those symbols as it is moved into G
+	G.resize(offsets[kept]);
+	pool.ParallelFor(kept, 1, [&](int, int i)
+	{
+		for (unsigned j = 0; i > 0 && j < parsed[i].size(); j++)
 		{
-			for (unsigned i = 0; i < G.size(); i++)
-			{
-				if (G[i].name == listIt->name)
-				{
-					//if vertex not visited, mark it visited and push it into the queue
-					if (G[i].visited == 0)
-					{
-						G[i].visited = 1;
-						q.push(G[i]);
-					}
-				}
-			}
+			parsed[i][j].symbol = remap[i][parsed[i][j].symbol];
+			for (typename list<Arc>::iterator listIt = parsed[i][j].edgelist.begin(); listIt != parsed[i][j].edgelist.end(); listIt++)
+				listIt->symbol = remap[i][listIt->symbol];
 		}
+		move(parsed[i].begin(), parsed[i].end(), G.begin() + offsets[i]);
+		vector<Node>().swap(parsed[i]);
+	});
+	RebuildIndex();
+
+	//every vertex is now known, so resolve the target index of each edge once; the
+	//index is only read, so the workers can share it
+	vector<long long> unresolved(pool.Size(), 0);
+	pool.ParallelFor(G.size(), 1024, [&](int worker, int j)
+	{
+		unresolved[worker] += ResolveEdges(G[j]);
+	});
+	for (unsigned w = 0; w < unresolved.size(); w++)
+		danglingEdges += unresolved[w];
+	RebuildPending();
+	populated = true;
+	NotifyReset();
+
+	lastLoad.bytes = file.Size();
+	lastLoad.vertices = G.size();
+	lastLoad.edges = edges;
+	lastLoad.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	if (!complete)
+	{
+		cout << "\n\nError reading " << path << " after " << G.size() << " vertices." << endl;
+		return -1;
 	}
 
-	//print any vertices unconnected with the starting vertex
-	for (unsigned i = 0; i < G.size(); i++)
+	cout << "\n\nGraph populated." << endl;
+	return 1;
+}
+
+/*******************************************************************************************
+*	Function Name:			ParseVertices
+*	Purpose:				reads vertices, each a name, optional coordinates after @, and
+*							edges of a name and a weight ended by #, until the block ends
+*	Input Parameters:		TokenScanner &scanner	the block to read
+*							vector<Node> &into		receives the vertices read, with the
+*													edge targets left unresolved
+*							StringTable &symbols	gives the symbols of the names read
+*							long long &edges		counts the edges read
+*	Return value:			bool	false if the block ends in the middle of a vertex, the
+*									vertex kept with the edges read before, or if a vertex
+*									is named #
+********************************************************************************************/
+template <class V, class W>
+bool Graph<V, W>::ParseVertices(TokenScanner &scanner, vector<Node> &into, StringTable &symbols, long long &edges)
+{
+	const char *token;		//the current token, from token up to tokenEnd
+	const char *tokenEnd;
+	bool complete = true;
+
+	//read the vertices
+	while (complete && scanner.Next(token, tokenEnd))
 	{
-		if (G[i].visited == 0)
+		//# ends each vertex, and LoadGraph cuts the file just after one, so no vertex
+		//may be named #
+		if (tokenEnd - token == 1 && *token == '#')
+			return false;
+
+		into.push_back(Node());
+		Node &vert = into.back();
+		vert.symbol = symbols.Intern(token, tokenEnd - token);
+
+		//read the edges, after the coordinates if there are any
+		complete = scanner.Next(token, tokenEnd);
+		if (complete && tokenEnd - token == 1 && *token == '@')
 		{
-			cout << "\t->(" << G[i].name << ") " << endl;
-			G[i].visited = 1;
+			complete = scanner.Next(token, tokenEnd) && TokenScanner::ParseNumber(token, tokenEnd, vert.x)
+				&& scanner.Next(token, tokenEnd) && TokenScanner::ParseNumber(token, tokenEnd, vert.y)
+				&& scanner.Next(token, tokenEnd);
+			vert.located = complete;
 		}
+
+		while (complete && !(tokenEnd - token == 1 && *token == '#'))
+		{
+			//read the weight and push into the list of the vertex
+			vert.edgelist.push_back(Arc());
+			Arc &edge = vert.edgelist.back();
+			edge.symbol = symbols.Intern(token, tokenEnd - token);
+			complete = scanner.Next(token, tokenEnd) && TokenScanner::ParseNumber(token, tokenEnd, edge.weight)
+				&& scanner.Next(token, tokenEnd);
+			if (complete)
+				edges++;
+			else
+				vert.edgelist.pop_back();
+		}
+	}
+	return complete;
+}
+
+/*******************************************************************************************
+*	Function Name:			LastLoad
+*	Purpose:				the size, counts, and time of the last graph read by LoadGraph
+*	Input Parameters:		none
+*	Return value:			const GraphLoadStats &
+********************************************************************************************/
+template <class V, class W>
+const GraphLoadStats &Graph<V, W>::LastLoad() const
+{
+	return lastLoad;
+}
+
+/*******************************************************************************************
+*	Function Name:			SaveBinary
+*	Purpose:				writes the graph to a binary snapshot with MappedGraph::Write
+*	Input Parameters:		const string &path	the file to write
+*	Return value:			int		-1 if the file cannot be written, 1 otherwise
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::SaveBinary(const string &path) const
+{
+	if (!MappedGraph<V, W>::Write(*this, path))
+	{
+		cout << "\n\nError writing " << path << endl;
+		return -1;
 	}
 
+	cout << "\n\nGraph saved." << endl;
+	return 1;
 }
 
 /*******************************************************************************************
-*	Function Name:			DFUtility
-*	Purpose:				recursive function for the depth first traversal
+*	Function Name:			LoadBinary
+*	Purpose:				reads in a graph from a binary snapshot. The snapshot is mapped
+*							and its checksum checked, then G is sized once and each vertex
+*							is copied out of the mapping with its edges, whose target
+*							indices are already in the snapshot.
+*	Input Parameters:		const string &path	the snapshot to read
+*	Return value:			int		-1 if the snapshot cannot be read or is damaged, 1 otherwise
+********************************************************************************************/
+template <class V, class W>
+int Graph<V, W>::LoadBinary(const string &path)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	MappedGraph<V, W> snapshot;
+	if (!snapshot.Open(path))
+	{
+		cout << "\n\nError opening " << path << " as a graph snapshot" << endl;
+		return -1;
+	}
+	if (!snapshot.Verify())
+	{
+		cout << "\n\nError reading " << path << ", the checksum does not match" << endl;
+		return -1;
+	}
+
+	//if the graph has data in it, delete the data; the observers are told once the
+	//new graph is built, so they never see it empty
+	if (populated)
+	{
+		G.clear();
+		names.Clear();
+		vertexOf.clear();
+		pending.clear();
+		danglingEdges = 0;
+	}
+
+	//the names first, so each edge can take the symbol of its target
+	int n = snapshot.VertexCount();
+	G.resize(n);
+	for (int i = 0; i < n; i++)
+	{
+		G[i].symbol = names.Intern(snapshot.Name(i));
+		G[i].located = snapshot.Location(i, G[i].x, G[i].y);
+	}
+	RebuildIndex();
+
+	for (int i = 0; i < n; i++)
+	{
+		snapshot.ForEachEdge(i, [&](int target, typename W::weightType weight)
+		{
+			Arc edge = { G[target].symbol, weight, target };
+			G[i].edgelist.push_back(edge);
+		});
+	}
+	populated = true;
+	NotifyReset();
+
+	lastLoad.bytes = snapshot.Bytes();
+	lastLoad.vertices = n;
+	lastLoad.edges = snapshot.EdgeCount();
+	lastLoad.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << "\n\nGraph populated." << endl;
+	return 1;
+}
+
+/*******************************************************************************************
+*	Function Name:			Breadth First Traversal
+*	Purpose:				breadth first traversal of a graph
 *	Input Parameters:		V &v	the starting vertex
 *	Return value:			void
 ********************************************************************************************/
 template <class V, class W>
-void Graph<V, W>::DFUtility(V &v)
+void Graph<V, W>::BFTraversal(V &v)
 {
-	static bool arrow = false;	//used for print formatting
-
+	vector<int> order;	//vertices in the order they are visited
+	Workspace ws;		//visited marks for this traversal
+	bool arrow = false;	//used for print formatting
 
+	//if vertex is not in the graph
 	int vIndex = isVertex(v);
-	if (G[vIndex].visited == 0)
+	if (vIndex == -1)
+	{
+		cout << "\n\nVertex " << v.name << " not found." << endl;
+		return;
+	}
+
+	//traverse from the starting vertex
+	BreadthFirstSearch(*this, vIndex, order, ws);
+
+	//print the traversal
+	for (unsigned i = 0; i < order.size(); i++)
 	{
-		//print the vertices
 		if (!arrow)
 		{
-			cout << "(" << G[vIndex].name << ")" << endl;
+			cout << "(" << Name(order[i]) << ")" << endl;
 			arrow = true;
 		}
 		else
-			cout << "\t->(" << G[vIndex].name << ")" << endl;
-
+			cout << "\t->(" << Name(order[i]) << ")" << endl;
 	}
 
-	//look through the edgelist of v
-	for (typename list<W>::const_iterator listIt = (G[vIndex].edgelist).begin(); listIt != (G[vIndex].edgelist).end(); listIt++)
+	//print any vertices unconnected with the starting vertex
+	for (unsigned i = 0; i < G.size(); i++)
 	{
-		//if v is not visited, mark it visited
-		if (G[vIndex].visited == 0)
+		if (ws.Mark(i) == 0)
 		{
-			G[vIndex].visited = 1;
-
-			//update v to the next vertex in the edgelist
-			v.name = listIt->name;
-			v.visited = 1;
-
-			//recursively call this function on the new v
-			DFUtility(v);
+			cout << "\t->(" << Name(i) << ") " << endl;
+			ws.SetMark(i, 1);
 		}
-
 	}
 
-
 }
 
 /*******************************************************************************************
 *	Function Name:			DFTraversal
-*	Purpose:				sets up and calls a depth first traversal using the helper
-*							function DFUtility
+*	Purpose:				depth first traversal of the graph, printing the vertices in the
+*							order DepthFirstSearch discovers them. The search keeps its own
+*							stack, so long chains of vertices cannot overflow the call stack.
 *	Input Parameters:		V &v	the starting vertex
 *	Return value:			void
 ********************************************************************************************/
@@ -796,7 +1452,9 @@ template <class V, class W>
 void Graph<V, W>::DFTraversal(V &v)
 {
 	int vIndex = isVertex(v);
-	bool arrow = false;
+	vector<int> order;	//vertices in the order they are discovered
+	Workspace ws;		//visited marks for this traversal
+	bool arrow = false;	//used for print formatting
 
 	//if the starting vertex is not found, return
 	if (vIndex == -1)
@@ -805,46 +1463,53 @@ void Graph<V, W>::DFTraversal(V &v)
 		return;
 	}
 
-	//mark all of the vertices as not visited
-	for (unsigned i = 0; i < G.size(); i++)
+	DepthFirstSearch(*this, vIndex, order, ws);
+
+	//print the traversal
+	for (unsigned i = 0; i < order.size(); i++)
 	{
-		G[i].visited = 0;
+		if (!arrow)
+		{
+			cout << "(" << Name(order[i]) << ")" << endl;
+			arrow = true;
+		}
+		else
+			cout << "\t->(" << Name(order[i]) << ")" << endl;
 	}
 
-	//call the recursive function
-	DFUtility(v);
-
 }
 
 /*******************************************************************************************
 *	Function Name:			MST
 *	Purpose:				finds the minimum spanning tree of the graph starting at a 
-*							specified source vertex
+*							specified source vertex, printing the trace through a PrimTrace
 *	Input Parameters:		V &v	the starting vertex
 *	Return value:			void
 ********************************************************************************************/
 template <class V, class W>
 void Graph<V, W>::MST(V &v)
 {
-	cout << "Finding the minimum spanning tree using Prim's Algorithm." << endl;
+	PrimTrace<Graph<V, W> > trace(*this);
+	MST(v, trace);
+}
 
-	V selection;		//minimum edge
-	queue<V> q;			//queue to check the vertices
-	vector<V> t;		//vector of vertices to be considered for the minimum spanning tree
-	
-	int selIndex;		//the index of the vertex to be put into the minimum spanning tree
-	
-	//the initial weight of the minimum spanning tree is 0
-	double mstCost = 0;
+/*******************************************************************************************
+*	Function Name:			MST
+*	Purpose:				finds the minimum spanning tree of the graph starting at a 
+*							specified source vertex with PrimSearch, telling a visitor as
+*							each vertex is added to the tree, then prints the tree
+*	Input Parameters:		V &v				the starting vertex
+*							Visitor &visitor	called with each vertex added to the tree
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+template <class Visitor>
+void Graph<V, W>::MST(V &v, Visitor &visitor)
+{
+	cout << "Finding the minimum spanning tree using Prim's Algorithm." << endl;
 
-	//set all of the vertices distances to the source vertex and their previous vertex to infinity, previous vertex to the source vertex, and none of them have been checked yet
-	for (unsigned i = 0; i < G.size(); i++)
-	{
-		G[i].component = false;
-		G[i].minDist = INT_MAX;
-		G[i].prev = v.name;
-		G[i].prevDist = INT_MAX;
-	}
+	Workspace ws;					//parents, edge costs, and tree marks for this tree
+	vector<vector<int> > children;	//the vertices each tree vertex connects to
 
 	//index of the source vertex
 	int vIndex = isVertex(v);
@@ -852,313 +1517,224 @@ void Graph<V, W>::MST(V &v)
 	//if the source vertex is not in the graph, return
 	if (vIndex == -1)
 	{
-		cout << "\n\nVertex " << G[vIndex].name << " not found." << endl;
+		cout << "\n\nVertex " << v.name << " not found." << endl;
 		return;
 	}
 
-	//set the source vertex's previous distance to 0, it is being checked so set component to true, and the minimum distance to 0
-	G[vIndex].prevDist = 0;
-	G[vIndex].component = true;
-	G[vIndex].minDist = 0;
-
 	//if the source vertex has no edgelist, there is no way out of that vertex and the minimum spanning tree is just that vertex with weight 0
 	if (G[vIndex].edgelist.empty())
 	{
-		cout << "\n\nNo path exitting " << G[vIndex].name << endl;
-		cout << "The weight of the minimum spanning tree starting at: " << G[vIndex].name << " is 0\n\n" << endl;
+		cout << "\n\nNo path exitting " << Name(vIndex) << endl;
+		cout << "The weight of the minimum spanning tree starting at: " << Name(vIndex) << " is 0\n\n" << endl;
 		return;
 	}
-	
-	//push the source vertex into the queue
-	q.push(v);
 
-	//while there are still vertices to check
-	while (!q.empty())
-	{
-		//current vertex
-		V curr;
+	//grow the tree from the source vertex
+	double mstCost = PrimSearch(*this, vIndex, ws, visitor);
 
-		//set current vertex to the start of the queue
-		curr = q.front();
-
-		//remove it from the queue
-		q.pop();
-
-		int currIndex = isVertex(curr);
-
-		//look through the current vertex's edgelist
-		for (typename list<W>::const_iterator listIt = (G[currIndex].edgelist).begin(); listIt != (G[currIndex].edgelist).end(); listIt++)
-		{
-			//look through the vertices
-			for (unsigned i = 0; i < G.size(); i++)
-			{
-				//if a vertex is in the edgelist
-				if (listIt->name == G[i].name)
-				{
-					//distance between the current vertex and the vertex in the edgelist
-					int cost = listIt->weight;
-
-					//if the minimum distance plus the weight is less than the minimum distance to the vertices in the edgelist
-					if (G[currIndex].minDist + cost < G[i].minDist)
-					{
-						
-						//if the vertex has not been checked yet
-						if (G[i].component == 0)
-						{
-
-							//set the distance to the previous vertex
-							G[i].prevDist = cost;
-
-							//set the new minimum distance to the first vertex plus the weight
-							G[i].minDist = G[currIndex].minDist + cost;
-
-							//the previous node is now the node just considered
-							G[i].prev = G[currIndex].name;
-
-							//push the vertex into the vector for consideration
-							t.push_back(G[i]);
-						}	
-					}
-				}
-			}
-		}
-
-		//if there are no more vertices to check, quit
-		if (t.empty())
-			break;
-
-		/*for (unsigned i = 0; i < t.size(); i++)
-			cout << t[i].name << " ";
-		cout << endl;*/
-
-		//find the minimum distance of all of the edges in consideration
-		unsigned vecIndex = 0;
-
-		//minimum edge starts at the first edge
-		selection = t[vecIndex];
-		for (unsigned i = 0; i < t.size(); i++)
-		{
-			//cout << "\nVertex " << t[i].name << " " << t[i].prevDist << endl;
-			
-			//if the next edge is smaller than the minumum edge, make that the minimum edge
-			if (t[i].prevDist < selection.prevDist)
-			{
-				vecIndex = i;
-				selection = t[vecIndex];
-			}
-			//cout << "Current selection " << selection.name << " " << selection.prevDist << endl;
-			
-		}
-
-		//cout << "Selects " << selection.name << " at position " << vecIndex << endl;
-		//get the index of the minimum edge
-		selIndex = isVertex(selection);
-
-		//that vertex has been considered, so set its component to 1
-		G[selIndex].component = 1;
-		
-		//remove that vertex from consideration
-		t.erase(t.begin() + vecIndex);
-
-		//look through the edgelist of the selected minimum vertex
-		for (typename list<W>::const_iterator listIt = (G[selIndex].edgelist).begin(); listIt != (G[selIndex].edgelist).end(); listIt++)
-		{
-			//look through the vertices in consideration
-			for (unsigned i = 0; i < t.size(); i++)
-			{
-				//look through the vertices in the graph
-				for (unsigned j = 0; j < G.size(); j++)
-				{
-					if (listIt->name == G[j].name)
-					{
-						if (listIt->name == t[i].name)
-						{
-							//if a smaller weight is found in the graph
-							if (listIt->weight < t[i].prevDist && G[j].component == 0)
-							{
-								//cout << "New weight " << t[i].name << " " << listIt->weight << endl;
-								//the new weight of the vertex in consideration is the smaller one found
-								t[i].prevDist = listIt->weight;
-								G[isVertex(t[i])].prevDist = listIt->weight;
-								G[isVertex(t[i])].prev = G[selIndex].name;
-							}
-						}
-					}
-				}
-			}
-		}
-
-		//push the selected vertex into the queue
-		q.push(selection);
-
-		//printing out the information for each vertex in each step
-		cout << endl;
-		for (unsigned i = 0; i < G.size(); i++)
-		{
-			cout << "Vertex Name:\t" << left << setw(15) << G[i].name;
-			if (G[i].prev == "")
-				cout << "Previous Node: " << setw(15) << "None";
-			else
-				cout << "Previous Node: " << setw(15) << G[i].prev;
-			if(G[i].prevDist == INT_MAX)
-				cout << setw(20) << "Distance from previous:\t" << setw(10) << "INF";
-			else
-				cout << setw(20) << "Distance from previous:\t" << setw(10) << G[i].prevDist;
-			cout << "Components:\t" << G[i].component;
-			if (G[i].minDist == INT_MAX)
-				cout << "\tDistance from source:\t" << setw(10) << "INF";
-			else
-				cout << "\tDistance from source:\t" << setw(10) << G[i].minDist;
-			cout << endl;
-		}
-		cout << "--------------------------------------------------------------------------------------------------------------------------------------------------------" << endl;
-	}
-	
-	//sum up the weight of the minimum edges to determine the weight of the minimum spanning tree
+	//group the tree vertices under their previous vertex
+	children.resize(G.size());
 	for (unsigned i = 0; i < G.size(); i++)
-		mstCost += G[i].prevDist;
-	
-
-	
-	
-	//printing out the minumum spanning tree starting at the source vertex
-	int printIndex = vIndex;
-
-	cout << "\n\nThe edges of the minimum spanning tree starting at " << G[vIndex].name << ":" << endl;
+	{
+		if (ws.Mark(i) && ws.Prev(i) != -1)
+			children[ws.Prev(i)].push_back(i);
+	}
 
-	//look through the graph
-	for (unsigned i = 1; i <= G.size(); i++)
+	//printing out the minumum spanning tree starting at the source vertex, then the rest of the vertices
+	cout << "\n\nThe edges of the minimum spanning tree starting at " << Name(vIndex) << ":" << endl;
+	for (int i = -1; i < (int)G.size(); i++)
 	{
-		//print each vertex in the minimum spanning tree
-		cout << "Vertex: " << G[printIndex].name << endl;
+		int printIndex = (i == -1) ? vIndex : i;
+		if (i == vIndex)
+			continue;
 
-		//look through the graph 
-		for (unsigned j = 0; j < G.size(); j++)
+		cout << "Vertex: " << Name(printIndex) << endl;
+		for (unsigned j = 0; j < children[printIndex].size(); j++)
 		{
-
-			//print the previous vertex of each selected vertex as long as the previous vertex is not the same as selected vertex
-			if (G[j].prev == G[printIndex].name && G[j].name != G[vIndex].name)
-				cout << "\t->(" << G[j].name << " with weight " << G[j].prevDist << ")" << endl;
-
+			int child = children[printIndex][j];
+			cout << "\t->(" << Name(child) << " with weight " << ws.Cost(child) << ")" << endl;
 		}
 		cout << endl;
-		printIndex = i;
 	}
 	
 	//print out the weight of the minimum spanning tree starting at the source vertex
-	cout << "\n\nThe weight of the minimum spanning tree starting at " << G[vIndex].name << " is: " << mstCost << "\n\n" << endl;
+	cout << "\n\nThe weight of the minimum spanning tree starting at " << Name(vIndex) << " is: " << mstCost << "\n\n" << endl;
+}
+
+/*******************************************************************************************
+*	Function Name:			SpanningTree
+*	Purpose:				finds the minimum spanning tree of a vertex's component with
+*							PrimTree, without printing
+*	Input Parameters:		V &v						the starting vertex
+*							vector<TreeEdge> &tree		filled with the tree edges
+*	Return value:			double	the weight of the tree, -1 if v is not in the graph
+********************************************************************************************/
+template <class V, class W>
+double Graph<V, W>::SpanningTree(V &v, vector<TreeEdge> &tree)
+{
+	Workspace ws;
+	int vIndex = isVertex(v);
+
+	tree.clear();
+	if (vIndex == -1)
+		return -1;
+	return PrimTree(*this, vIndex, tree, ws);
+}
+
+/*******************************************************************************************
+*	Function Name:			SpanningForest
+*	Purpose:				finds the minimum spanning forest of the whole graph with
+*							KruskalForest, without printing
+*	Input Parameters:		vector<TreeEdge> &tree		filled with the forest edges
+*	Return value:			double	the weight of the forest
+********************************************************************************************/
+template <class V, class W>
+double Graph<V, W>::SpanningForest(vector<TreeEdge> &tree)
+{
+	return KruskalForest(*this, tree);
 }
 
 /*******************************************************************************************
 *	Function Name:			FordShortestPath
 *	Purpose:				Calculates the shortest distance between all of the vertices
 *							in the graph using Ford's algorithm to handle negative
-*							edge weights
+*							edge weights, printing the queue trace through a FordTrace.
+*							Always searches, so every run prints the same trace.
 *	Input Parameters:		V &v	the starting vertex
 *	Return value:			none
 ********************************************************************************************/
 template <class V, class W>
 void Graph<V, W>::FordShortestPath(V &v1)
 {
-	deque<V> q;			//queue used during the calculation
-	stack<V> path;		//stack for holding the optimal path
-	deque<V> dq;
-	int iterations = 0;
+	FordTrace<Graph<V, W> > trace(*this);
+	FordShortestPath(v1, trace);
+}
 
-	bool arrow = false;		//used for print formatting
+/*******************************************************************************************
+*	Function Name:			CachedFordShortestPath
+*	Purpose:				prints the distances from the cached Ford tree of a vertex,
+*							without searching and so without a trace
+*	Input Parameters:		V &v	the starting vertex
+*	Return value:			bool	false, printing nothing, if no current tree from the
+*									vertex is cached
+********************************************************************************************/
+template <class V, class W>
+bool Graph<V, W>::CachedFordShortestPath(V &v1)
+{
 	int v1Index = isVertex(v1);
-	
+	const ShortestPathTree *tree = v1Index == -1 ? NULL : trees.Find(FORD_TREE, v1Index, revision);
+	if (tree == NULL)
+		return false;
 
-	int cost;			//weight
+	cout << "\n\nUsing the shortest paths found from " << Name(v1Index) << " by an earlier search." << endl;
+	PrintFordTree(v1Index, *tree);
+	return true;
+}
 
-	//set minimum distances to infinity, visited to 0, and prev to nothing
-	for (unsigned i = 0; i < G.size(); i++)
+/*******************************************************************************************
+*	Function Name:			FordShortestPath
+*	Purpose:				Calculates the shortest distance between all of the vertices
+*							in the graph using FordSearch, telling a visitor as vertices
+*							are pushed and popped, and prints the distances or the negative
+*							cycle that makes them unbounded. The tree found is cached.
+*	Input Parameters:		V &v				the starting vertex
+*							Visitor &visitor	called with each queued and popped vertex
+*	Return value:			none
+********************************************************************************************/
+template <class V, class W>
+template <class Visitor>
+void Graph<V, W>::FordShortestPath(V &v1, Visitor &visitor)
+{
+	Workspace ws;			//distances, previous vertices, and queue marks for this search
+	ShortestPathTree tree;	//the distances, or the negative cycle that leaves them unbounded
+
+	int v1Index = isVertex(v1);
+	if (v1Index == -1)
 	{
-		G[i].minDist = INT_MAX;
-		G[i].visited = 0;
-		G[i].prev = "";
+		cout << "\n\nVertex " << v1.name << " not found." << endl;
+		return;
 	}
 
-	//set starting vertex minimum distance to 0
-	G[v1Index].minDist = 0;
+	FordSearch(*this, v1Index, ws, tree.cycle, visitor);
+	tree.Assign(ws);
+	trees.Insert(FORD_TREE, v1Index, tree, revision);
+	PrintFordTree(v1Index, tree);
+}
 
-	//push start into queue
-	q.push_front(v1);
+/*******************************************************************************************
+*	Function Name:			PrintFordTree
+*	Purpose:				prints the distance and previous vertex of every vertex in a
+*							tree found by FordSearch, or the negative cycle reachable from
+*							the source that left the distances without a minimum
+*	Input Parameters:		int source						index of the starting vertex
+*							const ShortestPathTree &tree	the tree
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::PrintFordTree(int source, const ShortestPathTree &tree)
+{
+	bool arrow = false;		//used for print formatting
 
-	while (!q.empty())
+	//if a negative cycle is reachable the distances have no minimum, so print the cycle instead
+	if (!tree.cycle.empty())
 	{
-		//current vertex to consider
-		V curr;
-		cout << "\n\nIteration " << iterations << endl;
-		iterations++;
-		curr = q.front();
-		cout << curr.name << " added to the queue." << endl;
-		//remove from queue
-		cout << curr.name << " popped from the queue." << endl;
-		q.pop_front();
-		int currIndex = isVertex(curr);
-
-		//mark current as visited
-		G[currIndex].visited = 1;
-
-		//look through edgelist
-		for (typename list<W>::const_iterator listIt = (G[currIndex].edgelist).begin(); listIt != (G[currIndex].edgelist).end(); listIt++)
+		cout << "\n\nNegative cycle reachable from " << Name(source) << ", so the distances are unbounded:" << endl;
+		for (unsigned i = 0; i < tree.cycle.size(); i++)
 		{
-			//look through the vertices
-			for (unsigned i = 0; i < G.size(); i++)
+			if (!arrow)
 			{
-				//if a vertex is in the edgelist
-				if (listIt->name == G[i].name)
-				{
-					//get the weight
-					cost = listIt->weight;
-
-					//if the current minimum distance plus the cost is less than the minimum distances in the edgelist
-					if (G[currIndex].minDist + cost < G[i].minDist)
-					{
-						
-						//the minimum distance of the edge is the current minimum distance plus the cost
-						G[i].minDist = G[currIndex].minDist + cost;
-
-						//the vertex in the edgelist's previous vertex is the current vertex
-						G[i].prev = G[currIndex].name;
-
-						//if the vertex in the edgelist has not been visited, push it into the queue
-						if (G[i].visited == 0)
-						{
-							cout << G[i].name << " added to the queue." << endl;
-							q.push_front(G[i]);
-						}
-						
-					}
-				}
+				cout << "(" << Name(tree.cycle[i]) << ")" << endl;
+				arrow = true;
 			}
+			else
+				cout << "\t->(" << Name(tree.cycle[i]) << ")" << endl;
 		}
+		cout << "\t->(" << Name(tree.cycle[0]) << ")" << endl;
+		return;
 	}
 
-	//set the source vertex previous and minimum distance
-	G[v1Index].prev = "";
-	G[v1Index].minDist = 0;
-
 	//print the distances from the source
-	cout << "\n\nThe distances from the source " << G[v1Index].name << endl;
+	cout << "\n\nThe distances from the source " << Name(source) << endl;
 	for (unsigned i = 0; i < G.size(); i++)
 	{
 		//if there is no path to a vertex, the distance is infinite
-		if (G[i].minDist == INT_MAX)
+		if (tree.dist[i] == UNREACHABLE)
 		{
-			cout << "Vertex Name: " << G[i].name << " Distance: INF" << endl;
-			break;
+			cout << "Vertex Name: " << Name(i) << " Distance: INF" << endl;
+			continue;
 		}
 		
 		//print the connected vertices, their minimum distances, and their previous vertice
-		cout << "Vertex Name: " << G[i].name << "\tDistance: " << G[i].minDist << "\tPrevious Vertex: ";
-		if (G[i].prev == "")
+		cout << "Vertex Name: " << Name(i) << "\tDistance: " << tree.dist[i] << "\tPrevious Vertex: ";
+		if (tree.prev[i] == -1)
 			cout << "None" << endl;
 		else
-			cout << G[i].prev << endl;
+			cout << Name(tree.prev[i]) << endl;
 	}
 }
 
-#endif // !GRAPH_T
+/*******************************************************************************************
+*	Function Name:			Trees
+*	Purpose:				the cache of shortest path trees, for its size and statistics
+*	Input Parameters:		none
+*	Return value:			const TreeCache &
+********************************************************************************************/
+template <class V, class W>
+const TreeCache &Graph<V, W>::Trees() const
+{
+	return trees;
+}
 
+/*******************************************************************************************
+*	Function Name:			SetTreeCacheLimit
+*	Purpose:				changes the most bytes the cached shortest path trees may take
+*	Input Parameters:		size_t bytes	the new limit, 0 to turn the cache off
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void Graph<V, W>::SetTreeCacheLimit(std::size_t bytes)
+{
+	trees.SetLimit(bytes);
+}
+
+#endif // !GRAPH_T
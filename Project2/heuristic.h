@@ -0,0 +1,91 @@
+/**************************************************************************************************
+*
+*   File name :			heuristic.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the A* heuristics, implemented in heuristic.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	A heuristic is the policy AStarSearch (search.h) is instantiated with. It is any type with
+*		double operator()(int v, int target) const
+*	returning a lower bound on the distance from vertex index v to vertex index target. The
+*	search calls it directly on the template type, so a heuristic is inlined into the loop and
+*	ZeroHeuristic turns A* back into plain Dijkstra at no cost.
+*
+*	The geometric heuristics read the coordinates of the vertices from any graph type Adj with
+*		int VertexCount()
+*		bool Location(int v, double &x, double &y)	false if v has no coordinates
+*		void ForEachEdge(int u, F visit)
+*	and multiply the distance between two vertices by a scale that converts it to edge weight
+*	units. The scale is the largest that no edge undercuts, so the estimate never exceeds the
+*	weight of an edge and, by the triangle inequality, never exceeds the weight of a path
+*	either. If a vertex has no coordinates the scale is 0 and the estimate is always 0.
+*
+*	Class Names:
+*		ZeroHeuristic			estimates 0 everywhere
+*		EuclideanHeuristic		straight line distance between (x, y) points in the plane
+*		GreatCircleHeuristic	distance over the earth's surface between points whose x is
+*								the latitude and y the longitude, in degrees
+*
+****************************************************************************************************/
+
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+#include <vector>
+#include <cmath>
+
+class ZeroHeuristic
+{
+public:
+	double operator()(int, int) const { return 0; }
+};
+
+template <class Adj>
+class EuclideanHeuristic
+{
+public:
+	// Copies the coordinates of graph and picks the scale from its edges. O(V + E)
+	EuclideanHeuristic(const Adj &graph);
+
+	// The scale times the straight line distance from v to target
+	double operator()(int v, int target) const;
+
+	double Scale() const;	// Edge weight per unit of distance
+
+private:
+	double Between(int u, int v) const;
+	std::vector<double> x;
+	std::vector<double> y;
+	double scale;
+};
+
+template <class Adj>
+class GreatCircleHeuristic
+{
+public:
+	// Copies the coordinates of graph and picks the scale from its edges. O(V + E)
+	GreatCircleHeuristic(const Adj &graph);
+
+	// The scale times the great-circle distance in miles from v to target
+	double operator()(int v, int target) const;
+
+	double Scale() const;	// Edge weight per mile
+
+private:
+	double Between(int u, int v) const;
+	std::vector<double> latitude;	// in radians
+	std::vector<double> longitude;	// in radians
+	double scale;
+};
+
+// Largest scale s with s * between(u, v) <= weight for every edge u to v of graph, or 0
+// if a vertex has no coordinates. Used by the heuristics above.
+template <class Adj, class Between>
+double AdmissibleScale(const Adj &graph, Between between);
+
+#include "heuristic.t"
+#endif // !HEURISTIC_H
@@ -0,0 +1,177 @@
+/**************************************************************************************************
+*
+*   File name :			heuristic.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the A* heuristics defined in heuristic.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef HEURISTIC_T
+#define HEURISTIC_T
+
+/*******************************************************************************************
+*	Function Name:			AdmissibleScale
+*	Purpose:				finds the smallest ratio of an edge's weight to the distance
+*							between its ends. Edges whose ends are at the same point put no
+*							limit on the scale.
+*	Input Parameters:		const Adj &graph	the graph
+*							Between between		called as between(u, v) for the distance
+*	Return value:			double	the scale, 0 if it cannot be trusted
+********************************************************************************************/
+template <class Adj, class Between>
+double AdmissibleScale(const Adj &graph, Between between)
+{
+	double scale = -1;		//no edge has limited it yet
+	double x, y;
+
+	//without coordinates for every vertex a path could leave the plane the bound relies on
+	for (int v = 0; v < graph.VertexCount(); v++)
+	{
+		if (!graph.Location(v, x, y))
+			return 0;
+	}
+
+	for (int u = 0; u < graph.VertexCount(); u++)
+	{
+		graph.ForEachEdge(u, [&](int v, double weight)
+		{
+			double d = between(u, v);
+			if (d > 0 && (scale < 0 || weight / d < scale))
+				scale = weight / d;
+		});
+	}
+
+	//negative weights or no edges at all leave nothing to go on
+	if (scale < 0)
+		return 0;
+	return scale;
+}
+
+/*******************************************************************************************
+*	Function Name:			EuclideanHeuristic()	the constructor
+*	Purpose:				copies the (x, y) coordinates of each vertex and picks the scale
+*	Input Parameters:		const Adj &graph	the graph
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+EuclideanHeuristic<Adj>::EuclideanHeuristic(const Adj &graph)
+{
+	int n = graph.VertexCount();
+	x.assign(n, 0);
+	y.assign(n, 0);
+	for (int v = 0; v < n; v++)
+		graph.Location(v, x[v], y[v]);
+	scale = AdmissibleScale(graph, [&](int u, int v) { return Between(u, v); });
+}
+
+/*******************************************************************************************
+*	Function Name:			operator()
+*	Purpose:				the estimated distance from a vertex to the target
+*	Input Parameters:		int v		index of the vertex
+*							int target	index of the target vertex
+*	Return value:			double
+********************************************************************************************/
+template <class Adj>
+double EuclideanHeuristic<Adj>::operator()(int v, int target) const
+{
+	return scale * Between(v, target);
+}
+
+/*******************************************************************************************
+*	Function Name:			Scale
+*	Purpose:				the edge weight per unit of distance
+*	Input Parameters:		none
+*	Return value:			double
+********************************************************************************************/
+template <class Adj>
+double EuclideanHeuristic<Adj>::Scale() const
+{
+	return scale;
+}
+
+/*******************************************************************************************
+*	Function Name:			Between
+*	Purpose:				the straight line distance between two vertices
+*	Input Parameters:		int u	index of a vertex
+*							int v	index of another vertex
+*	Return value:			double
+********************************************************************************************/
+template <class Adj>
+double EuclideanHeuristic<Adj>::Between(int u, int v) const
+{
+	return std::sqrt((x[u] - x[v]) * (x[u] - x[v]) + (y[u] - y[v]) * (y[u] - y[v]));
+}
+
+/*******************************************************************************************
+*	Function Name:			GreatCircleHeuristic()	the constructor
+*	Purpose:				copies the latitude and longitude of each vertex, in radians, and
+*							picks the scale
+*	Input Parameters:		const Adj &graph	the graph
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+GreatCircleHeuristic<Adj>::GreatCircleHeuristic(const Adj &graph)
+{
+	const double RADIANS = 3.14159265358979323846 / 180;
+	int n = graph.VertexCount();
+	latitude.assign(n, 0);
+	longitude.assign(n, 0);
+	for (int v = 0; v < n; v++)
+	{
+		graph.Location(v, latitude[v], longitude[v]);
+		latitude[v] *= RADIANS;
+		longitude[v] *= RADIANS;
+	}
+	scale = AdmissibleScale(graph, [&](int u, int v) { return Between(u, v); });
+}
+
+/*******************************************************************************************
+*	Function Name:			operator()
+*	Purpose:				the estimated distance from a vertex to the target
+*	Input Parameters:		int v		index of the vertex
+*							int target	index of the target vertex
+*	Return value:			double
+********************************************************************************************/
+template <class Adj>
+double GreatCircleHeuristic<Adj>::operator()(int v, int target) const
+{
+	return scale * Between(v, target);
+}
+
+/*******************************************************************************************
+*	Function Name:			Scale
+*	Purpose:				the edge weight per mile
+*	Input Parameters:		none
+*	Return value:			double
+********************************************************************************************/
+template <class Adj>
+double GreatCircleHeuristic<Adj>::Scale() const
+{
+	return scale;
+}
+
+/*******************************************************************************************
+*	Function Name:			Between
+*	Purpose:				the great-circle distance in miles between two vertices, by the
+*							haversine formula
+*	Input Parameters:		int u	index of a vertex
+*							int v	index of another vertex
+*	Return value:			double
+********************************************************************************************/
+template <class Adj>
+double GreatCircleHeuristic<Adj>::Between(int u, int v) const
+{
+	const double EARTH_RADIUS = 3958.8;		//mean radius in miles
+	double dLat = std::sin((latitude[v] - latitude[u]) / 2);
+	double dLon = std::sin((longitude[v] - longitude[u]) / 2);
+	double a = dLat * dLat + std::cos(latitude[u]) * std::cos(latitude[v]) * dLon * dLon;
+	if (a > 1)
+		a = 1;
+	return 2 * EARTH_RADIUS * std::asin(std::sqrt(a));
+}
+
+#endif // !HEURISTIC_T
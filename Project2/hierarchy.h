@@ -0,0 +1,133 @@
+/**************************************************************************************************
+*
+*   File name :			hierarchy.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the ContractionHierarchy class, implemented in hierarchy.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		ContractionHierarchy
+*
+*	A contraction hierarchy of a static weighted graph, for answering many point to point
+*	shortest path queries. Building it removes the vertices one at a time, least important
+*	first, and whenever the only shortest path between two remaining neighbours of a removed
+*	vertex went through it, adds a shortcut edge between them. Every shortest path then has an
+*	equally short path that only climbs in the order up to some vertex and only descends from
+*	it, so a query runs a small Dijkstra search upward from each end and meets in the middle.
+*	Shortcuts remember the vertex they skip, so a path found with them can be unpacked into the
+*	edges of the original graph.
+*
+*	The hierarchy works on vertex indices and is built from any graph type Adj with a
+*	VertexCount() and a ForEachEdge(u, visit), such as Graph or CSRGraph. Edge weights must not
+*	be negative. It can be saved to a file and loaded again instead of being rebuilt.
+*
+*	Structs:
+*		Arc					an edge of the hierarchy: the other end, the weight, and the vertex
+*							a shortcut skips (-1 for an edge of the original graph)
+*		Shortcut			a shortcut found while contracting a vertex
+*
+*	Private data members:
+*		vector<int> rank					the position of each vertex in the contraction order
+*		upOffsets, upArcs					for each vertex, the edges to higher ranked vertices
+*		downOffsets, downArcs				for each vertex, the edges from higher ranked
+*											vertices, stored from this vertex's side
+*		int shortcuts						the number of shortcuts added
+*
+*	Private member functions:
+*		AddArc				adds an edge to a list, or lowers the weight of the one already there
+*		RemoveArc			removes the edge to a vertex from a list
+*		FindShortcuts		the shortcuts contracting a vertex needs, from witness searches
+*		Search				the bidirectional upward search of a query
+*		Step				settles the closest vertex of one side of the search
+*		FindArc				finds the hierarchy edge between two vertices
+*
+*	Public member functions:
+*		ContractionHierarchy	constructor for an empty hierarchy
+*		Build				contracts every vertex of a graph
+*		VertexCount			the number of vertices
+*		Rank				the position of a vertex in the contraction order
+*		ShortcutCount		the number of shortcuts added by Build
+*		Distance			the shortest distance between two vertices
+*		ShortestPath		the shortest distance and the path of original edges
+*		Save				writes the hierarchy to a binary file
+*		Load				reads a hierarchy written by Save
+*
+****************************************************************************************************/
+
+#ifndef HIERARCHY_H
+#define HIERARCHY_H
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include "workspace.h"
+
+class ContractionHierarchy
+{
+public:
+	ContractionHierarchy();		// Constructor
+
+	// Contracts every vertex of graph, replacing any hierarchy already built.
+	// Vertices are taken in order of twice the shortcuts they would add less the edges
+	// they remove, plus the number of their neighbours already contracted, recomputed
+	// when a vertex reaches the front. A shortcut is skipped when a witness search that
+	// avoids the vertex finds a path no longer than it.
+	template <class Adj>
+	void Build(const Adj &graph);
+
+	int VertexCount() const;		// Number of vertices
+	int Rank(int v) const;			// Position of vertex index v in the contraction order
+	int ShortcutCount() const;		// Number of shortcuts added by Build
+
+	// Shortest distance from source to target, UNREACHABLE if there is no path.
+	// forward and backward hold the two upward searches.
+	double Distance(int source, int target, Workspace &forward, Workspace &backward) const;
+
+	// Like Distance, and also fills path with the vertex indices of the shortest path
+	// in the original graph, from source to target; empty if there is no path
+	double ShortestPath(int source, int target, std::vector<int> &path, Workspace &forward, Workspace &backward) const;
+
+	// Writes the hierarchy to a binary file; returns false if it cannot be written
+	bool Save(const std::string &filename) const;
+
+	// Replaces the hierarchy with one read from a file written by Save; returns false,
+	// leaving the hierarchy empty, if the file cannot be read or is not a hierarchy
+	bool Load(const std::string &filename);
+
+private:
+	struct Arc
+	{
+		int to;
+		double weight;
+		int middle;
+	};
+
+	struct Shortcut
+	{
+		int from;
+		int to;
+		double weight;
+	};
+
+	static bool AddArc(std::vector<Arc> &arcs, int to, double weight, int middle);
+	static void RemoveArc(std::vector<Arc> &arcs, int to);
+	static void FindShortcuts(int v, const std::vector<std::vector<Arc> > &out, const std::vector<std::vector<Arc> > &in,
+		Workspace &witness, std::vector<Shortcut> &added);
+	double Search(int source, int target, Workspace &forward, Workspace &backward, int &meet) const;
+	void Step(bool up, Workspace &ws, const Workspace &other, double &best, int &meet) const;
+	bool FindArc(int from, int to, Arc &arc) const;
+
+	std::vector<int> rank;
+	std::vector<int> upOffsets;
+	std::vector<Arc> upArcs;
+	std::vector<int> downOffsets;
+	std::vector<Arc> downArcs;
+	int shortcuts;
+};
+#include "hierarchy.t"
+#endif // !HIERARCHY_H
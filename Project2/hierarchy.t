@@ -0,0 +1,531 @@
+/**************************************************************************************************
+*
+*   File name :			hierarchy.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the ContractionHierarchy class defined in hierarchy.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef HIERARCHY_T
+#define HIERARCHY_T
+
+/*******************************************************************************************
+*	Function Name:			ContractionHierarchy()			the constructor
+*	Purpose:				creates an empty hierarchy
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline ContractionHierarchy::ContractionHierarchy()
+{
+	upOffsets.push_back(0);
+	downOffsets.push_back(0);
+	shortcuts = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Build
+*	Purpose:				contracts every vertex of a graph. The remaining graph is kept
+*							as lists of edges into and out of each vertex. The vertex with
+*							the smallest priority is taken next, after its priority is
+*							recomputed from the shortcuts it needs now; if it has risen past
+*							the next vertex it goes back in the heap. Contracting a vertex
+*							moves its edges into the hierarchy, removes it from its
+*							neighbours' lists and adds its shortcuts between them.
+*	Input Parameters:		const Adj &graph	the graph, with no negative weights
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void ContractionHierarchy::Build(const Adj &graph)
+{
+	int n = graph.VertexCount();
+	std::vector<std::vector<Arc> > out(n);		//edges of the remaining graph leaving each vertex
+	std::vector<std::vector<Arc> > in(n);		//edges of the remaining graph entering each vertex
+	std::vector<std::vector<Arc> > up(n);		//hierarchy edges to higher ranked vertices
+	std::vector<std::vector<Arc> > down(n);		//hierarchy edges from higher ranked vertices
+	std::vector<int> contractedNeighbors(n, 0);
+	std::vector<Shortcut> added;
+	Workspace witness;
+	MinHeap<double> order;
+
+	//copy the graph, dropping loops and keeping the lightest of parallel edges
+	for (int u = 0; u < n; u++)
+		graph.ForEachEdge(u, [&](int v, double weight)
+		{
+			if (v != u && AddArc(out[u], v, weight, -1))
+				AddArc(in[v], u, weight, -1);
+		});
+
+	//order the vertices by the shortcuts they would add, counted twice, less the edges they remove
+	order.Reset(n);
+	for (int v = 0; v < n; v++)
+	{
+		FindShortcuts(v, out, in, witness, added);
+		order.Push(v, 2.0 * added.size() - out[v].size() - in[v].size());
+	}
+
+	rank.assign(n, -1);
+	shortcuts = 0;
+	int next = 0;
+	while (!order.Empty())
+	{
+		//recompute the priority of the front vertex, putting it back if it is no longer smallest
+		int v = order.Pop();
+		FindShortcuts(v, out, in, witness, added);
+		double priority = 2.0 * added.size() - out[v].size() - in[v].size() + contractedNeighbors[v];
+		if (!order.Empty() && priority > order.TopKey())
+		{
+			order.Push(v, priority);
+			continue;
+		}
+
+		//every remaining neighbour is contracted later, so its edges go up the hierarchy
+		rank[v] = next++;
+		up[v].swap(out[v]);
+		down[v].swap(in[v]);
+		for (unsigned i = 0; i < up[v].size(); i++)
+		{
+			RemoveArc(in[up[v][i].to], v);
+			contractedNeighbors[up[v][i].to]++;
+		}
+		for (unsigned i = 0; i < down[v].size(); i++)
+		{
+			RemoveArc(out[down[v][i].to], v);
+			contractedNeighbors[down[v][i].to]++;
+		}
+
+		//keep the shortest paths through v with shortcuts around it
+		for (unsigned i = 0; i < added.size(); i++)
+			if (AddArc(out[added[i].from], added[i].to, added[i].weight, v))
+			{
+				AddArc(in[added[i].to], added[i].from, added[i].weight, v);
+				shortcuts++;
+			}
+	}
+
+	//flatten the hierarchy into offset arrays
+	upOffsets.assign(1, 0);
+	downOffsets.assign(1, 0);
+	upArcs.clear();
+	downArcs.clear();
+	for (int v = 0; v < n; v++)
+	{
+		upArcs.insert(upArcs.end(), up[v].begin(), up[v].end());
+		downArcs.insert(downArcs.end(), down[v].begin(), down[v].end());
+		upOffsets.push_back(upArcs.size());
+		downOffsets.push_back(downArcs.size());
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			AddArc
+*	Purpose:				adds an edge to a list, or lowers the weight of the edge to the
+*							same vertex if the list already has a heavier one
+*	Input Parameters:		vector<Arc> &arcs	the list
+*							int to				the other end of the edge
+*							double weight		the weight of the edge
+*							int middle			the vertex a shortcut skips, -1 for none
+*	Return value:			bool	true if the edge was added or its weight lowered
+********************************************************************************************/
+inline bool ContractionHierarchy::AddArc(std::vector<Arc> &arcs, int to, double weight, int middle)
+{
+	for (unsigned i = 0; i < arcs.size(); i++)
+		if (arcs[i].to == to)
+		{
+			if (!(weight < arcs[i].weight))
+				return false;
+			arcs[i].weight = weight;
+			arcs[i].middle = middle;
+			return true;
+		}
+
+	Arc arc = { to, weight, middle };
+	arcs.push_back(arc);
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			RemoveArc
+*	Purpose:				removes the edge to a vertex from a list, moving the last edge
+*							into its place
+*	Input Parameters:		vector<Arc> &arcs	the list
+*							int to				the other end of the edge
+*	Return value:			void
+********************************************************************************************/
+inline void ContractionHierarchy::RemoveArc(std::vector<Arc> &arcs, int to)
+{
+	for (unsigned i = 0; i < arcs.size(); i++)
+		if (arcs[i].to == to)
+		{
+			arcs[i] = arcs.back();
+			arcs.pop_back();
+			return;
+		}
+}
+
+/*******************************************************************************************
+*	Function Name:			FindShortcuts
+*	Purpose:				the shortcuts contracting a vertex would need. For each edge
+*							into v a witness search runs from its start over the remaining
+*							graph without v, up to the longest path through v it has to
+*							beat. A path through v needs a shortcut unless the search found
+*							one no longer. The search also stops after WITNESS_LIMIT
+*							vertices, which can only add shortcuts that are not needed.
+*	Input Parameters:		int v								the vertex to contract
+*							const vector<vector<Arc>> &out		edges leaving each vertex
+*							const vector<vector<Arc>> &in		edges entering each vertex
+*							Workspace &witness					holds the witness searches
+*							vector<Shortcut> &added				receives the shortcuts
+*	Return value:			void
+********************************************************************************************/
+inline void ContractionHierarchy::FindShortcuts(int v, const std::vector<std::vector<Arc> > &out,
+	const std::vector<std::vector<Arc> > &in, Workspace &witness, std::vector<Shortcut> &added)
+{
+	const int WITNESS_LIMIT = 500;		//vertices a witness search may settle
+	added.clear();
+
+	for (unsigned i = 0; i < in[v].size(); i++)
+	{
+		int from = in[v][i].to;
+		double toV = in[v][i].weight;
+
+		//the longest path through v that a witness has to beat
+		double limit = -1;
+		for (unsigned j = 0; j < out[v].size(); j++)
+			if (out[v][j].to != from && toV + out[v][j].weight > limit)
+				limit = toV + out[v][j].weight;
+		if (limit < 0)
+			continue;
+
+		//Dijkstra from the start of the edge, never entering v
+		witness.Begin(out.size());
+		MinHeap<double> &heap = witness.Heap();
+		witness.SetDist(from, 0);
+		heap.Push(from, 0);
+		int settled = 0;
+		while (!heap.Empty() && heap.TopKey() <= limit && settled++ < WITNESS_LIMIT)
+		{
+			int curr = heap.Pop();
+			double currDist = witness.Dist(curr);
+			for (unsigned j = 0; j < out[curr].size(); j++)
+			{
+				int next = out[curr][j].to;
+				double nextDist = currDist + out[curr][j].weight;
+				if (next != v && nextDist < witness.Dist(next))
+				{
+					witness.SetDist(next, nextDist);
+					heap.Push(next, nextDist);
+				}
+			}
+		}
+		heap.Clear();
+
+		//a path through v without a witness needs a shortcut
+		for (unsigned j = 0; j < out[v].size(); j++)
+		{
+			Shortcut shortcut = { from, out[v][j].to, toV + out[v][j].weight };
+			if (shortcut.to != from && shortcut.weight < witness.Dist(shortcut.to))
+				added.push_back(shortcut);
+		}
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexCount
+*	Purpose:				the number of vertices of the hierarchy
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int ContractionHierarchy::VertexCount() const
+{
+	return rank.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			Rank
+*	Purpose:				the position of a vertex in the contraction order, 0 for the
+*							first vertex contracted
+*	Input Parameters:		int v	the vertex index
+*	Return value:			int
+********************************************************************************************/
+inline int ContractionHierarchy::Rank(int v) const
+{
+	return rank[v];
+}
+
+/*******************************************************************************************
+*	Function Name:			ShortcutCount
+*	Purpose:				the number of shortcuts added by Build
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int ContractionHierarchy::ShortcutCount() const
+{
+	return shortcuts;
+}
+
+/*******************************************************************************************
+*	Function Name:			Distance
+*	Purpose:				the shortest distance between two vertices
+*	Input Parameters:		int source				index of the starting vertex
+*							int target				index of the ending vertex
+*							Workspace &forward		holds the search up from source
+*							Workspace &backward		holds the search up from target
+*	Return value:			double	the distance, UNREACHABLE if there is no path
+********************************************************************************************/
+inline double ContractionHierarchy::Distance(int source, int target, Workspace &forward, Workspace &backward) const
+{
+	int meet;
+	return Search(source, target, forward, backward, meet);
+}
+
+/*******************************************************************************************
+*	Function Name:			ShortestPath
+*	Purpose:				the shortest distance between two vertices and the path of
+*							original edges. The upward halves of the path meet at the
+*							highest vertex on it; each of their edges that is a shortcut is
+*							replaced by the two edges around the vertex it skips, until only
+*							edges of the original graph are left.
+*	Input Parameters:		int source				index of the starting vertex
+*							int target				index of the ending vertex
+*							vector<int> &path		receives the path, source first
+*							Workspace &forward		holds the search up from source
+*							Workspace &backward		holds the search up from target
+*	Return value:			double	the distance, UNREACHABLE if there is no path
+********************************************************************************************/
+inline double ContractionHierarchy::ShortestPath(int source, int target, std::vector<int> &path,
+	Workspace &forward, Workspace &backward) const
+{
+	int meet;
+	double distance = Search(source, target, forward, backward, meet);
+	path.clear();
+	if (meet == -1)
+		return distance;
+
+	//the vertices of the hierarchy path, up from the source to meet then down to the target
+	std::vector<int> route;
+	for (int v = meet; v != -1; v = forward.Prev(v))
+		route.push_back(v);
+	std::reverse(route.begin(), route.end());
+	for (int v = backward.Prev(meet); v != -1; v = backward.Prev(v))
+		route.push_back(v);
+
+	//unpack each hierarchy edge, left half first
+	std::vector<std::pair<int, int> > stack;
+	path.push_back(source);
+	for (unsigned i = 1; i < route.size(); i++)
+	{
+		stack.push_back(std::make_pair(route[i - 1], route[i]));
+		while (!stack.empty())
+		{
+			std::pair<int, int> edge = stack.back();
+			stack.pop_back();
+
+			Arc arc = { edge.second, 0, -1 };
+			FindArc(edge.first, edge.second, arc);
+			if (arc.middle == -1)
+				path.push_back(edge.second);
+			else
+			{
+				stack.push_back(std::make_pair(arc.middle, edge.second));
+				stack.push_back(std::make_pair(edge.first, arc.middle));
+			}
+		}
+	}
+
+	return distance;
+}
+
+/*******************************************************************************************
+*	Function Name:			Search
+*	Purpose:				the query: Dijkstra upward from the source over the edges to
+*							higher vertices and upward from the target over the edges from
+*							them, one step of each side in turn. A side stops once its
+*							closest vertex is no closer than the best path through a vertex
+*							both sides reached, since the highest vertex of a shortest path
+*							is settled by both sides before then.
+*	Input Parameters:		int source				index of the starting vertex
+*							int target				index of the ending vertex
+*							Workspace &forward		holds the search up from source
+*							Workspace &backward		holds the search up from target
+*							int &meet				receives the highest vertex of the
+*													path, -1 if there is no path
+*	Return value:			double	the distance, UNREACHABLE if there is no path
+********************************************************************************************/
+inline double ContractionHierarchy::Search(int source, int target, Workspace &forward, Workspace &backward, int &meet) const
+{
+	int n = VertexCount();
+	forward.Begin(n);
+	backward.Begin(n);
+	MinHeap<double> &forwardHeap = forward.Heap();
+	MinHeap<double> &backwardHeap = backward.Heap();
+
+	forward.SetDist(source, 0);
+	forwardHeap.Push(source, 0);
+	backward.SetDist(target, 0);
+	backwardHeap.Push(target, 0);
+
+	double best = UNREACHABLE;
+	meet = -1;
+	for (;;)
+	{
+		bool forwardLeft = !forwardHeap.Empty() && forwardHeap.TopKey() < best;
+		bool backwardLeft = !backwardHeap.Empty() && backwardHeap.TopKey() < best;
+		if (!forwardLeft && !backwardLeft)
+			break;
+		if (forwardLeft)
+			Step(true, forward, backward, best, meet);
+		if (backwardLeft)
+			Step(false, backward, forward, best, meet);
+	}
+	forwardHeap.Clear();
+	backwardHeap.Clear();
+
+	return best;
+}
+
+/*******************************************************************************************
+*	Function Name:			Step
+*	Purpose:				settles the closest vertex of one side of a query, updating the
+*							best path if the other side has reached it. A vertex that can be
+*							reached more cheaply down an edge from a higher vertex already
+*							reached is not on a shortest upward path, so it is stalled
+*							rather than expanded.
+*	Input Parameters:		bool up					true for the side searching from the
+*													source over upward edges
+*							Workspace &ws			this side's search
+*							const Workspace &other	the other side's search
+*							double &best			the best distance through a vertex both
+*													sides reached
+*							int &meet				the vertex of best
+*	Return value:			void
+********************************************************************************************/
+inline void ContractionHierarchy::Step(bool up, Workspace &ws, const Workspace &other, double &best, int &meet) const
+{
+	const std::vector<int> &offsets = up ? upOffsets : downOffsets;
+	const std::vector<Arc> &arcs = up ? upArcs : downArcs;
+	const std::vector<int> &stallOffsets = up ? downOffsets : upOffsets;
+	const std::vector<Arc> &stallArcs = up ? downArcs : upArcs;
+	MinHeap<double> &heap = ws.Heap();
+
+	int curr = heap.Pop();
+	double currDist = ws.Dist(curr);
+	if (currDist + other.Dist(curr) < best)
+	{
+		best = currDist + other.Dist(curr);
+		meet = curr;
+	}
+
+	//stall on demand
+	for (int i = stallOffsets[curr]; i < stallOffsets[curr + 1]; i++)
+		if (ws.Dist(stallArcs[i].to) + stallArcs[i].weight < currDist)
+			return;
+
+	for (int i = offsets[curr]; i < offsets[curr + 1]; i++)
+	{
+		int next = arcs[i].to;
+		double nextDist = currDist + arcs[i].weight;
+		if (nextDist < ws.Dist(next))
+		{
+			ws.SetDist(next, nextDist);
+			ws.SetPrev(next, curr);
+			heap.Push(next, nextDist);
+		}
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			FindArc
+*	Purpose:				finds the hierarchy edge from one vertex to another. It is kept
+*							with the lower ranked of the two: among the upward edges of the
+*							start, or among the edges from higher vertices of the end.
+*	Input Parameters:		int from		the start of the edge
+*							int to			the end of the edge
+*							Arc &arc		receives the edge, seen from the start
+*	Return value:			bool	false if there is no such edge
+********************************************************************************************/
+inline bool ContractionHierarchy::FindArc(int from, int to, Arc &arc) const
+{
+	bool up = rank[from] < rank[to];
+	int low = up ? from : to;
+	int high = up ? to : from;
+	const std::vector<int> &offsets = up ? upOffsets : downOffsets;
+	const std::vector<Arc> &arcs = up ? upArcs : downArcs;
+
+	for (int i = offsets[low]; i < offsets[low + 1]; i++)
+		if (arcs[i].to == high)
+		{
+			arc = arcs[i];
+			arc.to = to;
+			return true;
+		}
+	return false;
+}
+
+/*******************************************************************************************
+*	Function Name:			Save
+*	Purpose:				writes the hierarchy to a binary file: a tag, the vertex and
+*							edge counts, then the ranks, offsets and edges as stored
+*	Input Parameters:		const string &filename	the file to write
+*	Return value:			bool	false if the file cannot be written
+********************************************************************************************/
+inline bool ContractionHierarchy::Save(const std::string &filename) const
+{
+	std::ofstream outFile(filename.c_str(), std::ios::binary);
+	if (!outFile)
+		return false;
+
+	int counts[4] = { VertexCount(), (int)upArcs.size(), (int)downArcs.size(), shortcuts };
+	outFile.write("CH01", 4);
+	outFile.write((const char *)counts, sizeof(counts));
+	outFile.write((const char *)rank.data(), rank.size() * sizeof(int));
+	outFile.write((const char *)upOffsets.data(), upOffsets.size() * sizeof(int));
+	outFile.write((const char *)upArcs.data(), upArcs.size() * sizeof(Arc));
+	outFile.write((const char *)downOffsets.data(), downOffsets.size() * sizeof(int));
+	outFile.write((const char *)downArcs.data(), downArcs.size() * sizeof(Arc));
+
+	return (bool)outFile;
+}
+
+/*******************************************************************************************
+*	Function Name:			Load
+*	Purpose:				reads a hierarchy written by Save, checking the tag, the counts
+*							and that the offsets fit the edges read
+*	Input Parameters:		const string &filename	the file to read
+*	Return value:			bool	false, leaving the hierarchy empty, if the file cannot
+*									be read or is not a hierarchy
+********************************************************************************************/
+inline bool ContractionHierarchy::Load(const std::string &filename)
+{
+	*this = ContractionHierarchy();
+	std::ifstream inFile(filename.c_str(), std::ios::binary);
+	char tag[4];
+	int counts[4];
+	if (!inFile.read(tag, 4) || std::string(tag, 4) != "CH01" || !inFile.read((char *)counts, sizeof(counts))
+		|| counts[0] < 0 || counts[1] < 0 || counts[2] < 0)
+		return false;
+
+	ContractionHierarchy loaded;
+	loaded.rank.resize(counts[0]);
+	loaded.upOffsets.resize(counts[0] + 1);
+	loaded.upArcs.resize(counts[1]);
+	loaded.downOffsets.resize(counts[0] + 1);
+	loaded.downArcs.resize(counts[2]);
+	loaded.shortcuts = counts[3];
+	inFile.read((char *)loaded.rank.data(), loaded.rank.size() * sizeof(int));
+	inFile.read((char *)loaded.upOffsets.data(), loaded.upOffsets.size() * sizeof(int));
+	inFile.read((char *)loaded.upArcs.data(), loaded.upArcs.size() * sizeof(Arc));
+	inFile.read((char *)loaded.downOffsets.data(), loaded.downOffsets.size() * sizeof(int));
+	inFile.read((char *)loaded.downArcs.data(), loaded.downArcs.size() * sizeof(Arc));
+	if (!inFile || loaded.upOffsets[0] != 0 || loaded.upOffsets[counts[0]] != counts[1]
+		|| loaded.downOffsets[0] != 0 || loaded.downOffsets[counts[0]] != counts[2])
+		return false;
+
+	*this = loaded;
+	return true;
+}
+
+#endif // !HIERARCHY_T
@@ -0,0 +1,108 @@
+/**************************************************************************************************
+*
+*   File name :			landmarks.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the Landmarks class, implemented in landmarks.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		Landmarks
+*
+*	A landmark distance oracle (ALT). A few vertices are chosen as landmarks and the shortest
+*	distances from each landmark to every vertex and from every vertex to each landmark are
+*	stored. By the triangle inequality, for a landmark L
+*		dist(v, t) >= dist(L, t) - dist(L, v)	and		dist(v, t) >= dist(v, L) - dist(t, L)
+*	so the largest of these over the landmarks is a lower bound on any distance, found in time
+*	proportional to the number of landmarks. The bound follows the heuristic interface of
+*	heuristic.h, so AStarSearch or Graph::ShortestDistance can be run with a Landmarks object
+*	to steer the search toward the target. Edge weights must not be negative.
+*
+*	The tables take 2 * sizeof(D) bytes per vertex per landmark. D is double by default; float
+*	halves the memory, and the bound is then lowered by the rounding error of the stored values
+*	so it is still a lower bound.
+*
+*	Landmarks are chosen by one of two methods:
+*		FARTHEST_LANDMARKS	each landmark is the vertex farthest from the landmarks chosen so
+*							far. A vertex no landmark reaches counts as the farthest, so every
+*							part of a disconnected graph gets a landmark while there are enough.
+*		AVOID_LANDMARKS		each landmark is a leaf of the shortest path tree from a random
+*							root, found by following the subtree whose vertices the current
+*							landmarks bound worst.
+*
+*	Private data members:
+*		vector<int> landmarks		the vertex index of each landmark
+*		int width					the number of landmarks asked for, the row length of
+*									the tables
+*		vector<D> from				from[v * width + i] is the distance from landmark i to v
+*		vector<D> to				to[v * width + i] is the distance from v to landmark i
+*
+*	Private member functions:
+*		Farthest			the vertex farthest from the landmarks chosen so far
+*		Avoid				the leaf of the worst bounded subtree of a shortest path tree
+*		Fill				runs the searches that fill the tables for one landmark
+*
+*	Public member functions:
+*		Landmarks			constructor for an oracle with no landmarks
+*		Build				chooses the landmarks of a graph and fills the tables
+*		Count				the number of landmarks
+*		Landmark			the vertex index of a landmark
+*		Bytes				the memory taken by the tables
+*		LowerBound			a lower bound on the distance between two vertices
+*		operator()			LowerBound, for use as an A* heuristic
+*
+****************************************************************************************************/
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+#include <vector>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <algorithm>
+#include "search.h"
+
+enum LandmarkSelection { FARTHEST_LANDMARKS, AVOID_LANDMARKS };
+
+template <class D = double>
+class Landmarks
+{
+	static_assert(std::is_floating_point<D>::value, "landmark distances must be a floating point type");
+
+public:
+	Landmarks();	// Constructor
+
+	// Chooses up to count landmarks of graph and fills the tables with one search from
+	// each landmark over graph and one over reverse, the same graph with every edge
+	// reversed (such as Graph::Freeze().Transpose()). Replaces any landmarks already
+	// built. O(count (V + E) log V)
+	template <class Adj, class RevAdj>
+	void Build(const Adj &graph, const RevAdj &reverse, int count, LandmarkSelection selection = FARTHEST_LANDMARKS);
+
+	int Count() const;				// Number of landmarks
+	int Landmark(int i) const;		// Vertex index of landmark i
+	std::size_t Bytes() const;		// Memory taken by the distance tables
+
+	// A lower bound on the distance from vertex index v to vertex index target,
+	// UNREACHABLE if a landmark shows there is no path. O(Count())
+	double LowerBound(int v, int target) const;
+
+	// LowerBound, so a Landmarks object is an A* heuristic
+	double operator()(int v, int target) const { return LowerBound(v, target); }
+
+private:
+	int Farthest(int n) const;
+	template <class Adj>
+	int Avoid(const Adj &graph, int root, Workspace &ws) const;
+	template <class Adj, class RevAdj>
+	void Fill(const Adj &graph, const RevAdj &reverse, int i, Workspace &ws);
+	std::vector<int> landmarks;
+	int width;
+	std::vector<D> from;
+	std::vector<D> to;
+};
+#include "landmarks.t"
+#endif // !LANDMARKS_H
@@ -0,0 +1,276 @@
+/**************************************************************************************************
+*
+*   File name :			landmarks.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the functions for the Landmarks class defined in landmarks.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef LANDMARKS_T
+#define LANDMARKS_T
+
+/*******************************************************************************************
+*	Function Name:			Landmarks()			the constructor
+*	Purpose:				creates an oracle with no landmarks, whose bound is always 0
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+template <class D>
+Landmarks<D>::Landmarks()
+{
+	width = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Build
+*	Purpose:				chooses the landmarks one at a time, each from the tables of
+*							the ones before it, and fills the tables for it. The roots of the
+*							avoid method come from a fixed seed so a graph always gets the
+*							same landmarks. The first landmark, with no tables yet to measure
+*							from, is always chosen by the avoid method.
+*	Input Parameters:		const Adj &graph				the graph
+*							const RevAdj &reverse			the graph with every edge reversed
+*							int count						the number of landmarks, at most
+*															the number of vertices
+*							LandmarkSelection selection		how to choose them
+*	Return value:			void
+********************************************************************************************/
+template <class D>
+template <class Adj, class RevAdj>
+void Landmarks<D>::Build(const Adj &graph, const RevAdj &reverse, int count, LandmarkSelection selection)
+{
+	int n = graph.VertexCount();
+	width = std::max(0, std::min(count, n));
+	landmarks.clear();
+	from.assign((std::size_t)n * width, (D)UNREACHABLE);
+	to.assign((std::size_t)n * width, (D)UNREACHABLE);
+
+	std::mt19937 random(1);
+	Workspace ws;
+	while ((int)landmarks.size() < width)
+	{
+		int next = -1;
+		if (selection == AVOID_LANDMARKS || landmarks.empty())
+			next = Avoid(graph, random() % n, ws);
+		if (next == -1)
+			next = Farthest(n);
+
+		landmarks.push_back(next);
+		Fill(graph, reverse, landmarks.size() - 1, ws);
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			Farthest
+*	Purpose:				the vertex that is not a landmark with the largest round trip
+*							distance to its nearest landmark, a vertex some landmark cannot
+*							reach or be reached from counting as infinitely far
+*	Input Parameters:		int n	the number of vertices
+*	Return value:			int		the vertex index
+********************************************************************************************/
+template <class D>
+int Landmarks<D>::Farthest(int n) const
+{
+	int farthest = -1;
+	double farthestDist = -1;
+	for (int v = 0; v < n; v++)
+	{
+		if (std::find(landmarks.begin(), landmarks.end(), v) != landmarks.end())
+			continue;
+
+		double nearest = UNREACHABLE;
+		for (unsigned i = 0; i < landmarks.size(); i++)
+			nearest = std::min(nearest, (double)from[(std::size_t)v * width + i] + to[(std::size_t)v * width + i]);
+		if (nearest > farthestDist)
+		{
+			farthest = v;
+			farthestDist = nearest;
+		}
+	}
+	return farthest;
+}
+
+/*******************************************************************************************
+*	Function Name:			Avoid
+*	Purpose:				the avoid method. Each vertex of the shortest path tree from
+*							the root is weighted by how far its distance from the root is
+*							above the current lower bound, and a subtree holding a landmark
+*							weighs nothing. Starting at the root, the walk moves to the
+*							heaviest child until none weighs anything; the vertex it stops
+*							at is far from the root in a direction no landmark covers.
+*	Input Parameters:		const Adj &graph	the graph
+*							int root			index of the root of the tree
+*							Workspace &ws		holds the search from the root
+*	Return value:			int		the vertex index, -1 if every subtree holds a landmark
+********************************************************************************************/
+template <class D>
+template <class Adj>
+int Landmarks<D>::Avoid(const Adj &graph, int root, Workspace &ws) const
+{
+	int n = graph.VertexCount();
+	DijkstraSearch(graph, root, -1, ws);
+	const std::vector<int> &reached = ws.Touched();
+
+	//the children of each vertex of the tree, as offsets into one array
+	std::vector<int> offsets(n + 1, 0);
+	std::vector<int> children(reached.size());
+	for (unsigned k = 0; k < reached.size(); k++)
+		if (ws.Prev(reached[k]) != -1)
+			offsets[ws.Prev(reached[k]) + 1]++;
+	for (int v = 0; v < n; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<int> next(offsets.begin(), offsets.end() - 1);
+	for (unsigned k = 0; k < reached.size(); k++)
+		if (ws.Prev(reached[k]) != -1)
+			children[next[ws.Prev(reached[k])]++] = reached[k];
+
+	//the tree in breadth first order, so each vertex comes before its children
+	std::vector<int> order(1, root);
+	for (unsigned k = 0; k < order.size(); k++)
+		for (int c = offsets[order[k]]; c < offsets[order[k] + 1]; c++)
+			order.push_back(children[c]);
+
+	//weigh the subtrees, children first
+	std::vector<double> size(n, 0);
+	std::vector<char> covered(n, 0);
+	for (unsigned i = 0; i < landmarks.size(); i++)
+		covered[landmarks[i]] = 1;
+	for (int k = order.size() - 1; k >= 0; k--)
+	{
+		int v = order[k];
+		int parent = ws.Prev(v);
+		if (covered[v])
+		{
+			size[v] = 0;
+			if (parent != -1)
+				covered[parent] = 1;
+			continue;
+		}
+		size[v] += ws.Dist(v) - LowerBound(root, v);
+		if (parent != -1)
+			size[parent] += size[v];
+	}
+
+	//walk down the heaviest subtrees
+	int v = root;
+	for (;;)
+	{
+		int heaviest = -1;
+		for (int c = offsets[v]; c < offsets[v + 1]; c++)
+			if (!covered[children[c]] && size[children[c]] > 0 && (heaviest == -1 || size[children[c]] > size[heaviest]))
+				heaviest = children[c];
+		if (heaviest == -1)
+			break;
+		v = heaviest;
+	}
+
+	if (v == root && (covered[root] || offsets[root] == offsets[root + 1]))
+		return -1;
+	return v;
+}
+
+/*******************************************************************************************
+*	Function Name:			Fill
+*	Purpose:				fills the tables for one landmark with a search from it over the
+*							graph and one over the reversed graph
+*	Input Parameters:		const Adj &graph			the graph
+*							const RevAdj &reverse		the graph with every edge reversed
+*							int i						the number of the landmark
+*							Workspace &ws				holds the searches
+*	Return value:			void
+********************************************************************************************/
+template <class D>
+template <class Adj, class RevAdj>
+void Landmarks<D>::Fill(const Adj &graph, const RevAdj &reverse, int i, Workspace &ws)
+{
+	int n = graph.VertexCount();
+
+	DijkstraSearch(graph, landmarks[i], -1, ws);
+	for (int v = 0; v < n; v++)
+		from[(std::size_t)v * width + i] = (D)ws.Dist(v);
+
+	DijkstraSearch(reverse, landmarks[i], -1, ws);
+	for (int v = 0; v < n; v++)
+		to[(std::size_t)v * width + i] = (D)ws.Dist(v);
+}
+
+/*******************************************************************************************
+*	Function Name:			Count
+*	Purpose:				the number of landmarks
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class D>
+int Landmarks<D>::Count() const
+{
+	return landmarks.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			Landmark
+*	Purpose:				the vertex index of a landmark
+*	Input Parameters:		int i	the number of the landmark
+*	Return value:			int
+********************************************************************************************/
+template <class D>
+int Landmarks<D>::Landmark(int i) const
+{
+	return landmarks[i];
+}
+
+/*******************************************************************************************
+*	Function Name:			Bytes
+*	Purpose:				the memory taken by the distance tables
+*	Input Parameters:		none
+*	Return value:			size_t
+********************************************************************************************/
+template <class D>
+std::size_t Landmarks<D>::Bytes() const
+{
+	return (from.size() + to.size()) * sizeof(D);
+}
+
+/*******************************************************************************************
+*	Function Name:			LowerBound
+*	Purpose:				the largest triangle inequality bound over the landmarks. Each
+*							bound is lowered by the most the two stored distances can have
+*							been rounded, in the table and in adding up the path weights,
+*							so it holds for float tables too. A landmark that
+*							reaches v but not target, or is reached from target but not
+*							from v, shows there is no path.
+*	Input Parameters:		int v		index of the starting vertex
+*							int target	index of the ending vertex
+*	Return value:			double	the bound, UNREACHABLE if there is no path
+********************************************************************************************/
+template <class D>
+double Landmarks<D>::LowerBound(int v, int target) const
+{
+	const double EPSILON = std::numeric_limits<D>::epsilon() + 1e-12;		//relative rounding of a stored distance and of the sums that made it
+	const D *fromV = from.data() + (std::size_t)v * width;
+	const D *fromTarget = from.data() + (std::size_t)target * width;
+	const D *toV = to.data() + (std::size_t)v * width;
+	const D *toTarget = to.data() + (std::size_t)target * width;
+
+	double best = 0;
+	for (unsigned i = 0; i < landmarks.size(); i++)
+	{
+		//landmark to target, less landmark to v
+		double ahead = (double)fromTarget[i] - fromV[i];
+		//v to landmark, less target to landmark
+		double behind = (double)toV[i] - toTarget[i];
+		if (ahead == UNREACHABLE || behind == UNREACHABLE)
+			return UNREACHABLE;
+
+		if (ahead > best)
+			best = std::max(best, ahead - EPSILON * ((double)fromTarget[i] + fromV[i]));
+		if (behind > best)
+			best = std::max(best, behind - EPSILON * ((double)toV[i] + toTarget[i]));
+	}
+	return best;
+}
+
+#endif // !LANDMARKS_T
@@ -0,0 +1,128 @@
+/**************************************************************************************************
+*
+*   File name :			mappedfile.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the MappedFile and TokenScanner classes, implemented in mappedfile.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Names:
+*		MappedFile		a file mapped read-only into memory, so it is read straight from the
+*						page cache instead of being copied through a stream buffer. Uses
+*						CreateFileMapping on Windows and mmap elsewhere.
+*		TokenScanner	splits a block of text into whitespace separated tokens without
+*						copying them, and parses numbers from them
+*
+*	Private data members of MappedFile:
+*		const char *data	the first byte of the mapping, NULL if nothing is mapped
+*		size_t size			the length of the file
+*		file, mapping		the Windows handles of the open file and its mapping
+*
+*	Public member functions of MappedFile:
+*		MappedFile			constructor for an object with no file mapped
+*		~MappedFile			destructor, unmaps the file
+*		Open				maps a file, unmapping any file mapped before
+*		Close				unmaps the file
+*		Data				the first byte of the file
+*		Size				the length of the file
+*
+*	Private data members of TokenScanner:
+*		const char *at		the next byte to scan
+*		const char *end		one past the last byte
+*
+*	Public member functions of TokenScanner:
+*		TokenScanner		constructor, scans a block of bytes
+*		Next				the next token
+*		Count				the number of times a token occurs in the rest of the block
+*		SkipPast			moves past the next occurrence of a token
+*		Position			the next byte to scan
+*		ParseNumber			parses a whole token as a number
+*
+****************************************************************************************************/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+#include <limits>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+class MappedFile
+{
+public:
+	MappedFile();	// Constructor
+	~MappedFile();	// Destructor
+
+	// Maps the file at path read-only, unmapping any file mapped before. Returns
+	// false if it cannot be opened or mapped. An empty file maps with no data.
+	bool Open(const std::string &path);
+
+	void Close();					// Unmaps the file
+	const char *Data() const;		// First byte of the file, NULL if none is mapped
+	std::size_t Size() const;		// Length of the file in bytes
+
+private:
+	MappedFile(const MappedFile &);
+	MappedFile &operator=(const MappedFile &);
+	const char *data;
+	std::size_t size;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+};
+
+class TokenScanner
+{
+public:
+	// Scans the bytes from begin up to end
+	TokenScanner(const char *begin, const char *end);
+
+	// Sets token and tokenEnd to the next whitespace separated token; returns false,
+	// leaving them alone, at the end of the block
+	bool Next(const char *&token, const char *&tokenEnd);
+
+	// Number of tokens equal to word in the rest of the block, without moving on.
+	// O(bytes left), mostly in memchr
+	std::size_t Count(const char *word) const;
+
+	// Moves past the next token equal to word. The scanner may start in the middle
+	// of a token, which is skipped first. Returns false, at the end of the block, if
+	// there is none.
+	bool SkipPast(const char *word);
+
+	// The next byte to scan, just after the last token read or skipped
+	const char *Position() const;
+
+	// Parses the whole token as a number of type T; returns false if it is not one.
+	// Integers are parsed by hand, and rejected if they do not fit in T; floating
+	// point goes through strtod.
+	template <class T>
+	static bool ParseNumber(const char *token, const char *tokenEnd, T &value);
+
+private:
+	static bool IsSpace(char c);
+	template <class T>
+	static bool ParseNumber(const char *token, const char *tokenEnd, T &value, std::true_type);
+	template <class T>
+	static bool ParseNumber(const char *token, const char *tokenEnd, T &value, std::false_type);
+	const char *at;
+	const char *end;
+};
+#include "mappedfile.t"
+#endif // !MAPPEDFILE_H
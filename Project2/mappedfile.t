@@ -0,0 +1,353 @@
+/**************************************************************************************************
+*
+*   File name :			mappedfile.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the MappedFile and TokenScanner classes defined in
+*	mappedfile.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef MAPPEDFILE_T
+#define MAPPEDFILE_T
+
+/*******************************************************************************************
+*	Function Name:			MappedFile()			the constructor
+*	Purpose:				creates an object with no file mapped
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline MappedFile::MappedFile()
+{
+	data = NULL;
+	size = 0;
+#ifdef _WIN32
+	file = INVALID_HANDLE_VALUE;
+	mapping = NULL;
+#endif
+}
+
+/*******************************************************************************************
+*	Function Name:			~MappedFile()			the destructor
+*	Purpose:				unmaps the file
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline MappedFile::~MappedFile()
+{
+	Close();
+}
+
+/*******************************************************************************************
+*	Function Name:			Open
+*	Purpose:				maps a file read-only, hinting that it will be read front to
+*							back so the system reads ahead
+*	Input Parameters:		const string &path	the file to map
+*	Return value:			bool	false if the file cannot be opened or mapped
+********************************************************************************************/
+inline bool MappedFile::Open(const std::string &path)
+{
+	Close();
+
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(file, &length))
+	{
+		Close();
+		return false;
+	}
+	size = (std::size_t)length.QuadPart;
+	if (size == 0)
+		return true;
+
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		Close();
+		return false;
+	}
+	data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL)
+	{
+		Close();
+		return false;
+	}
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) == -1)
+	{
+		close(fd);
+		return false;
+	}
+	size = info.st_size;
+	if (size == 0)
+	{
+		close(fd);
+		return true;
+	}
+
+	//the mapping keeps the file open, so the descriptor is not needed once it is made
+	void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED)
+	{
+		size = 0;
+		return false;
+	}
+	madvise(mapped, size, MADV_SEQUENTIAL);
+	data = (const char *)mapped;
+#endif
+
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			Close
+*	Purpose:				unmaps the file, if one is mapped
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+inline void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (data != NULL)
+		UnmapViewOfFile(data);
+	if (mapping != NULL)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+	mapping = NULL;
+	file = INVALID_HANDLE_VALUE;
+#else
+	if (data != NULL)
+		munmap((void *)data, size);
+#endif
+	data = NULL;
+	size = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Data
+*	Purpose:				the first byte of the mapped file
+*	Input Parameters:		none
+*	Return value:			const char *	NULL if no file, or an empty one, is mapped
+********************************************************************************************/
+inline const char *MappedFile::Data() const
+{
+	return data;
+}
+
+/*******************************************************************************************
+*	Function Name:			Size
+*	Purpose:				the length of the mapped file
+*	Input Parameters:		none
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t MappedFile::Size() const
+{
+	return size;
+}
+
+/*******************************************************************************************
+*	Function Name:			TokenScanner()			the constructor
+*	Purpose:				starts scanning a block of bytes
+*	Input Parameters:		const char *begin	the first byte
+*							const char *end		one past the last byte
+*	Return value:			none
+********************************************************************************************/
+inline TokenScanner::TokenScanner(const char *begin, const char *end)
+{
+	at = begin;
+	this->end = end;
+}
+
+/*******************************************************************************************
+*	Function Name:			IsSpace
+*	Purpose:				tests whether a byte separates tokens, as isspace does in the
+*							C locale
+*	Input Parameters:		char c	the byte
+*	Return value:			bool
+********************************************************************************************/
+inline bool TokenScanner::IsSpace(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*******************************************************************************************
+*	Function Name:			Next
+*	Purpose:				finds the next token, skipping the whitespace before it
+*	Input Parameters:		const char *&token		receives the first byte of the token
+*							const char *&tokenEnd	receives one past its last byte
+*	Return value:			bool	false if only whitespace is left
+********************************************************************************************/
+inline bool TokenScanner::Next(const char *&token, const char *&tokenEnd)
+{
+	while (at != end && IsSpace(*at))
+		at++;
+	if (at == end)
+		return false;
+
+	token = at;
+	while (at != end && !IsSpace(*at))
+		at++;
+	tokenEnd = at;
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			Count
+*	Purpose:				counts the tokens equal to a word in the rest of the block,
+*							jumping between occurrences of its first byte with memchr
+*	Input Parameters:		const char *word	the word, not empty
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t TokenScanner::Count(const char *word) const
+{
+	std::size_t length = std::strlen(word);
+	std::size_t count = 0;
+	const char *p = at;
+	while (p != end && (p = (const char *)std::memchr(p, word[0], end - p)) != NULL)
+	{
+		//a match must be the whole token
+		if ((p == at || IsSpace(p[-1])) && (std::size_t)(end - p) >= length && std::memcmp(p, word, length) == 0
+			&& (p + length == end || IsSpace(p[length])))
+			count++;
+		p++;
+	}
+	return count;
+}
+
+/*******************************************************************************************
+*	Function Name:			SkipPast
+*	Purpose:				moves past the next token equal to a word, first finishing any
+*							token the scanner starts in, so it can be started anywhere in
+*							the block
+*	Input Parameters:		const char *word	the word, not empty
+*	Return value:			bool	false if the word is not in the rest of the block
+********************************************************************************************/
+inline bool TokenScanner::SkipPast(const char *word)
+{
+	std::size_t length = std::strlen(word);
+	const char *token;
+	const char *tokenEnd;
+
+	while (at != end && !IsSpace(*at))
+		at++;
+	while (Next(token, tokenEnd))
+	{
+		if ((std::size_t)(tokenEnd - token) == length && std::memcmp(token, word, length) == 0)
+			return true;
+	}
+	return false;
+}
+
+/*******************************************************************************************
+*	Function Name:			Position
+*	Purpose:				the next byte to scan
+*	Input Parameters:		none
+*	Return value:			const char *
+********************************************************************************************/
+inline const char *TokenScanner::Position() const
+{
+	return at;
+}
+
+/*******************************************************************************************
+*	Function Name:			ParseNumber
+*	Purpose:				parses a whole token as a number, by hand for integer types and
+*							through strtod for floating point types
+*	Input Parameters:		const char *token		the first byte of the token
+*							const char *tokenEnd	one past its last byte
+*							T &value				receives the number
+*	Return value:			bool	false if the token is not a number of that type
+********************************************************************************************/
+template <class T>
+bool TokenScanner::ParseNumber(const char *token, const char *tokenEnd, T &value)
+{
+	return ParseNumber(token, tokenEnd, value, std::is_integral<T>());
+}
+
+/*******************************************************************************************
+*	Function Name:			ParseNumber
+*	Purpose:				parses an optionally signed decimal integer, checking each digit
+*							against the range of T before it is added so an integer too
+*							large for T is rejected instead of overflowing
+*	Input Parameters:		const char *token		the first byte of the token
+*							const char *tokenEnd	one past its last byte
+*							T &value				receives the number
+*	Return value:			bool	false if the token is not an integer, or does not fit in T
+********************************************************************************************/
+template <class T>
+bool TokenScanner::ParseNumber(const char *token, const char *tokenEnd, T &value, std::true_type)
+{
+	bool negative = false;
+	if (token != tokenEnd && (*token == '-' || *token == '+'))
+		negative = *token++ == '-';
+	if (token == tokenEnd || (negative && !std::is_signed<T>::value))
+		return false;
+
+	//a negative number is built downward, so the most negative value of T can be read
+	const T high = std::numeric_limits<T>::max();
+	const T low = std::numeric_limits<T>::min();
+	T result = 0;
+	for (; token != tokenEnd; token++)
+	{
+		if (*token < '0' || *token > '9')
+			return false;
+		T digit = *token - '0';
+		if (negative)
+		{
+			if (result < (low + digit) / 10)
+				return false;
+			result = result * 10 - digit;
+		}
+		else
+		{
+			if (result > (high - digit) / 10)
+				return false;
+			result = result * 10 + digit;
+		}
+	}
+	value = result;
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			ParseNumber
+*	Purpose:				parses a floating point number with strtod. The token is copied
+*							first, since the mapped bytes after it are not a terminator.
+*	Input Parameters:		const char *token		the first byte of the token
+*							const char *tokenEnd	one past its last byte
+*							T &value				receives the number
+*	Return value:			bool	false if the token is not a number
+********************************************************************************************/
+template <class T>
+bool TokenScanner::ParseNumber(const char *token, const char *tokenEnd, T &value, std::false_type)
+{
+	char buffer[64];
+	std::size_t length = tokenEnd - token;
+	if (length == 0 || length >= sizeof(buffer))
+		return false;
+	std::memcpy(buffer, token, length);
+	buffer[length] = '\0';
+
+	char *parsed;
+	double result = std::strtod(buffer, &parsed);
+	if (parsed != buffer + length)
+		return false;
+	value = (T)result;
+	return true;
+}
+
+#endif // !MAPPEDFILE_T
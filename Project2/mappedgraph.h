@@ -0,0 +1,177 @@
+/**************************************************************************************************
+*
+*   File name :			mappedgraph.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the MappedGraph class, implemented in mappedgraph.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		MappedGraph
+*
+*	A read-only graph queried in place from a binary snapshot file, written by Write or
+*	Graph::SaveBinary. Opening a snapshot maps it and checks its header, O(1), so nothing
+*	is parsed or copied; the vertex and edge arrays are read straight from the mapping. It
+*	has the adjacency interface of Graph and CSRGraph, so the engines in search.h and
+*	hierarchy.h run on it directly.
+*
+*	Layout of a snapshot, in the byte order of the machine that wrote it. The header is
+*	followed by the sections in this order, each starting on an 8 byte boundary:
+*		SnapshotHeader		magic, version, byte order check, weight type, counts,
+*							body length, and checksum of everything after the header
+*		offsets				int[V + 1], the edges of vertex v are offsets[v] to offsets[v + 1]
+*		targets				int[E], the target vertex index of each edge
+*		weights				weightType[E], the weight of each edge
+*		nameOffsets			unsigned long long[V + 1], the name of vertex v is the bytes
+*							nameOffsets[v] to nameOffsets[v + 1] of names
+*		names				char[], the vertex names back to back, without terminators
+*		slots				int[slotCount], an open addressing hash table from a name to
+*							its vertex index, probed linearly, -1 for an empty slot
+*		located				char[V], 1 if the vertex has coordinates
+*		coordinates			double[2V], the x and y of each vertex
+*
+*	Private data members:
+*		MappedFile file		the mapped snapshot
+*		header				the header at the start of the mapping
+*		offsets, targets, weights, nameOffsets, names, slots, located, coordinates
+*							the sections of the mapping
+*
+*	SnapshotBuilder (snapshotbuilder.h) is a friend, to write snapshots with the same layout,
+*	hash, and checksum.
+*
+*	Private member functions:
+*		Hash				the FNV-1a hash of a name
+*		Checksum			folds a block of bytes into a checksum, eight at a time
+*		Layout				the offset of each section from the start of the body
+*		Pad					the length of a section rounded up to 8 bytes
+*
+*	Public member functions:
+*		MappedGraph			constructor for an object with no snapshot open
+*		Open				maps a snapshot and checks its header and length
+*		Close				unmaps the snapshot
+*		IsOpen				tests whether a snapshot is open
+*		Verify				recomputes the checksum of the open snapshot
+*		Bytes				the length of the snapshot file
+*		VertexCount			the number of vertices
+*		EdgeCount			the number of edges
+*		Degree				the number of edges leaving a vertex
+*		Find				the index of a vertex name, through the hash table
+*		Name				the name of a vertex index
+*		Location			the coordinates of a vertex index
+*		ForEachEdge			visits the target index and weight of each edge leaving a vertex
+*		ForEachEdgeUntil	visits the edges leaving a vertex until the visitor returns true
+*		Write				writes a snapshot of any graph with the adjacency interface
+*
+****************************************************************************************************/
+
+#ifndef MAPPEDGRAPH_H
+#define MAPPEDGRAPH_H
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include "mappedfile.h"
+
+const unsigned SNAPSHOT_VERSION = 1;		// Version written by MappedGraph::Write
+const unsigned SNAPSHOT_BYTE_ORDER = 0x01020304;	// Reads differently on a machine of the other byte order
+
+struct SnapshotHeader
+{
+	char magic[8];						// "GRAPHSNP"
+	unsigned version;					// SNAPSHOT_VERSION
+	unsigned byteOrder;					// SNAPSHOT_BYTE_ORDER
+	unsigned weightBytes;				// sizeof the weight type
+	unsigned weightIntegral;			// 1 if the weight type is an integer type
+	unsigned long long vertexCount;		// V
+	unsigned long long edgeCount;		// E
+	unsigned long long nameBytes;		// Total length of the vertex names
+	unsigned long long slotCount;		// Size of the name hash table, a power of two
+	unsigned long long bodyBytes;		// Length of everything after the header
+	unsigned long long checksum;		// Checksum of everything after the header
+};
+
+template <class V, class W>
+class MappedGraph
+{
+public:
+	typedef typename V::nameType nameType;	// Type of the vertex names
+	typedef typename W::weightType weightType;	// Type of the edge weights
+
+	MappedGraph();	// Constructor
+
+	// Maps the snapshot at path read-only, closing any snapshot open before. Checks
+	// the header, the weight type, and the file length but not the checksum, so it
+	// takes the same time for any size of graph. Returns false if the file cannot be
+	// mapped or is not a snapshot this class can read.
+	bool Open(const std::string &path);
+
+	void Close();				// Unmaps the snapshot
+	bool IsOpen() const;		// Tests whether a snapshot is open
+
+	// Recomputes the checksum of the open snapshot and compares it with the header,
+	// to catch a damaged file before trusting it. O(file size)
+	bool Verify() const;
+
+	// Length of the open snapshot file in bytes
+	std::size_t Bytes() const;
+
+	// Number of vertices; vertex indices run from 0 to VertexCount() - 1
+	int VertexCount() const;
+
+	// Number of edges
+	int EdgeCount() const;
+
+	// Number of edges leaving vertex index u
+	int Degree(int u) const;
+
+	// Index of the vertex with the given name, -1 if it is not in the snapshot.
+	// O(1) on average
+	int Find(const nameType &name) const;
+
+	// Name of vertex index v, copied out of the name table
+	nameType Name(int v) const;
+
+	// Sets x and y to the coordinates of vertex index u; returns false, leaving them
+	// alone, if it has none
+	bool Location(int u, double &x, double &y) const;
+
+	// Calls visit(target index, weight) for each edge leaving vertex index u
+	template <class F>
+	void ForEachEdge(int u, F visit) const;
+
+	// Like ForEachEdge, but stops at the first edge for which visit returns true.
+	// Returns whether it stopped early.
+	template <class F>
+	bool ForEachEdgeUntil(int u, F visit) const;
+
+	// Writes a snapshot of graph to the file at path. The graph needs VertexCount,
+	// ForEachEdge, Name, and Location; vertex indices in the snapshot match its own.
+	// Returns false if the file cannot be written. O(V + E)
+	template <class Adj>
+	static bool Write(const Adj &graph, const std::string &path);
+
+private:
+	template <class, class> friend class SnapshotBuilder;
+	MappedGraph(const MappedGraph &);
+	MappedGraph &operator=(const MappedGraph &);
+	static unsigned long long Hash(const char *name, std::size_t length);
+	static unsigned long long Checksum(unsigned long long sum, const char *block, std::size_t length);
+	static void Layout(const SnapshotHeader &header, unsigned long long section[9]);
+	static unsigned long long Pad(unsigned long long length);
+	MappedFile file;
+	const SnapshotHeader *header;
+	const int *offsets;
+	const int *targets;
+	const weightType *weights;
+	const unsigned long long *nameOffsets;
+	const char *names;
+	const int *slots;
+	const char *located;
+	const double *coordinates;
+};
+#include "mappedgraph.t"
+#endif // !MAPPEDGRAPH_H
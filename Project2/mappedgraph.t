@@ -0,0 +1,468 @@
+/**************************************************************************************************
+*
+*   File name :			mappedgraph.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the functions for the memory mapped graph snapshot defined
+*	in mappedgraph.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef MAPPEDGRAPH_T
+#define MAPPEDGRAPH_T
+
+/*******************************************************************************************
+*	Function Name:			MappedGraph()			the constructor
+*	Purpose:				creates an object with no snapshot open
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+template <class V, class W>
+MappedGraph<V, W>::MappedGraph()
+{
+	Close();
+}
+
+/*******************************************************************************************
+*	Function Name:			Open
+*	Purpose:				maps a snapshot and points each section into the mapping, after
+*							checking that the header is one this class wrote for the same
+*							weight type and that the file is as long as the header says
+*	Input Parameters:		const std::string &path		the snapshot to map
+*	Return value:			bool	true if the snapshot was opened
+********************************************************************************************/
+template <class V, class W>
+bool MappedGraph<V, W>::Open(const std::string &path)
+{
+	static_assert(std::is_same<nameType, std::string>::value, "snapshots store vertex names as strings");
+
+	Close();
+	if (!file.Open(path) || file.Size() < sizeof(SnapshotHeader))
+	{
+		file.Close();
+		return false;
+	}
+
+	//check the header before trusting any of its counts
+	const SnapshotHeader *head = reinterpret_cast<const SnapshotHeader *>(file.Data());
+	unsigned long long section[9];
+	bool valid = memcmp(head->magic, "GRAPHSNP", 8) == 0
+		&& head->version == SNAPSHOT_VERSION
+		&& head->byteOrder == SNAPSHOT_BYTE_ORDER
+		&& head->weightBytes == sizeof(weightType)
+		&& head->weightIntegral == (std::is_integral<weightType>::value ? 1u : 0u)
+		&& head->vertexCount < 0x7fffffffULL
+		&& head->edgeCount < 0x7fffffffULL
+		&& head->slotCount > head->vertexCount
+		&& (head->slotCount & (head->slotCount - 1)) == 0;
+	if (valid)
+	{
+		Layout(*head, section);
+		valid = head->bodyBytes == section[8] && file.Size() - sizeof(SnapshotHeader) == head->bodyBytes;
+	}
+	if (!valid)
+	{
+		file.Close();
+		return false;
+	}
+
+	//the sections follow the header, each on an 8 byte boundary
+	const char *body = file.Data() + sizeof(SnapshotHeader);
+	header = head;
+	offsets = reinterpret_cast<const int *>(body + section[0]);
+	targets = reinterpret_cast<const int *>(body + section[1]);
+	weights = reinterpret_cast<const weightType *>(body + section[2]);
+	nameOffsets = reinterpret_cast<const unsigned long long *>(body + section[3]);
+	names = body + section[4];
+	slots = reinterpret_cast<const int *>(body + section[5]);
+	located = body + section[6];
+	coordinates = reinterpret_cast<const double *>(body + section[7]);
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			Close
+*	Purpose:				unmaps the snapshot
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void MappedGraph<V, W>::Close()
+{
+	file.Close();
+	header = NULL;
+	offsets = NULL;
+	targets = NULL;
+	weights = NULL;
+	nameOffsets = NULL;
+	names = NULL;
+	slots = NULL;
+	located = NULL;
+	coordinates = NULL;
+}
+
+/*******************************************************************************************
+*	Function Name:			IsOpen
+*	Purpose:				tests whether a snapshot is open
+*	Input Parameters:		none
+*	Return value:			bool
+********************************************************************************************/
+template <class V, class W>
+bool MappedGraph<V, W>::IsOpen() const
+{
+	return header != NULL;
+}
+
+/*******************************************************************************************
+*	Function Name:			Verify
+*	Purpose:				recomputes the checksum of everything after the header and
+*							compares it with the one the header holds
+*	Input Parameters:		none
+*	Return value:			bool	true if a snapshot is open and its checksum matches
+********************************************************************************************/
+template <class V, class W>
+bool MappedGraph<V, W>::Verify() const
+{
+	if (header == NULL)
+		return false;
+	return Checksum(14695981039346656037ULL, file.Data() + sizeof(SnapshotHeader), header->bodyBytes) == header->checksum;
+}
+
+/*******************************************************************************************
+*	Function Name:			Bytes
+*	Purpose:				the length of the open snapshot file
+*	Input Parameters:		none
+*	Return value:			std::size_t		0 if no snapshot is open
+********************************************************************************************/
+template <class V, class W>
+std::size_t MappedGraph<V, W>::Bytes() const
+{
+	return file.Size();
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexCount
+*	Purpose:				the number of vertices in the snapshot
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int MappedGraph<V, W>::VertexCount() const
+{
+	return header == NULL ? 0 : (int)header->vertexCount;
+}
+
+/*******************************************************************************************
+*	Function Name:			EdgeCount
+*	Purpose:				the number of edges in the snapshot
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int MappedGraph<V, W>::EdgeCount() const
+{
+	return header == NULL ? 0 : (int)header->edgeCount;
+}
+
+/*******************************************************************************************
+*	Function Name:			Degree
+*	Purpose:				the number of edges leaving a vertex
+*	Input Parameters:		int u	index of the vertex
+*	Return value:			int
+********************************************************************************************/
+template <class V, class W>
+int MappedGraph<V, W>::Degree(int u) const
+{
+	return offsets[u + 1] - offsets[u];
+}
+
+/*******************************************************************************************
+*	Function Name:			Find
+*	Purpose:				looks up the index of a vertex by name, probing the hash table
+*							from the slot of the name's hash until the name or an empty
+*							slot is found
+*	Input Parameters:		const nameType &name	the name of the vertex
+*	Return value:			int		the index of the vertex, -1 if it is not in the snapshot
+********************************************************************************************/
+template <class V, class W>
+int MappedGraph<V, W>::Find(const nameType &name) const
+{
+	if (header == NULL)
+		return -1;
+
+	unsigned long long mask = header->slotCount - 1;
+	for (unsigned long long slot = Hash(name.data(), name.size()) & mask; slots[slot] != -1; slot = (slot + 1) & mask)
+	{
+		int v = slots[slot];
+		unsigned long long length = nameOffsets[v + 1] - nameOffsets[v];
+		if (length == name.size() && memcmp(names + nameOffsets[v], name.data(), length) == 0)
+			return v;
+	}
+	return -1;
+}
+
+/*******************************************************************************************
+*	Function Name:			Name
+*	Purpose:				the name of a vertex, copied out of the name table
+*	Input Parameters:		int v	index of the vertex
+*	Return value:			nameType
+********************************************************************************************/
+template <class V, class W>
+typename MappedGraph<V, W>::nameType MappedGraph<V, W>::Name(int v) const
+{
+	return nameType(names + nameOffsets[v], names + nameOffsets[v + 1]);
+}
+
+/*******************************************************************************************
+*	Function Name:			Location
+*	Purpose:				the coordinates of a vertex, if it has any
+*	Input Parameters:		int u		index of the vertex
+*							double &x	set to the first coordinate
+*							double &y	set to the second coordinate
+*	Return value:			bool	true if the vertex has coordinates
+********************************************************************************************/
+template <class V, class W>
+bool MappedGraph<V, W>::Location(int u, double &x, double &y) const
+{
+	if (!located[u])
+		return false;
+	x = coordinates[2 * u];
+	y = coordinates[2 * u + 1];
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdge
+*	Purpose:				calls visit with the target index and weight of each edge
+*							leaving a vertex, reading its row of the mapping
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight)
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+template <class F>
+void MappedGraph<V, W>::ForEachEdge(int u, F visit) const
+{
+	for (int e = offsets[u]; e < offsets[u + 1]; e++)
+		visit(targets[e], weights[e]);
+}
+
+/*******************************************************************************************
+*	Function Name:			ForEachEdgeUntil
+*	Purpose:				calls visit with the target index and weight of each edge
+*							leaving a vertex until visit returns true
+*	Input Parameters:		int u		index of the vertex
+*							F visit		called as visit(int target, weight), returning bool
+*	Return value:			bool	true if visit returned true for some edge
+********************************************************************************************/
+template <class V, class W>
+template <class F>
+bool MappedGraph<V, W>::ForEachEdgeUntil(int u, F visit) const
+{
+	for (int e = offsets[u]; e < offsets[u + 1]; e++)
+	{
+		if (visit(targets[e], weights[e]))
+			return true;
+	}
+	return false;
+}
+
+/*******************************************************************************************
+*	Function Name:			Write
+*	Purpose:				writes a snapshot of a graph. The sections are built in memory,
+*							then written one after another behind a blank header, folding
+*							each into the checksum; the header is written last, once the
+*							checksum is known.
+*	Input Parameters:		const Adj &graph			the graph to write
+*							const std::string &path		the file to write it to
+*	Return value:			bool	false if the file cannot be written
+********************************************************************************************/
+template <class V, class W>
+template <class Adj>
+bool MappedGraph<V, W>::Write(const Adj &graph, const std::string &path)
+{
+	static_assert(std::is_same<nameType, std::string>::value, "snapshots store vertex names as strings");
+	static_assert(std::is_trivially_copyable<weightType>::value, "snapshots store edge weights as raw bytes");
+
+	int n = graph.VertexCount();
+	std::vector<int> rowOffsets(1, 0);
+	std::vector<int> edgeTargets;
+	std::vector<weightType> edgeWeights;
+	std::vector<unsigned long long> nameStarts(1, 0);
+	std::string nameBytes;
+	std::vector<char> hasLocation(n, 0);
+	std::vector<double> xy(2 * n, 0);
+	rowOffsets.reserve(n + 1);
+	nameStarts.reserve(n + 1);
+
+	//lay the rows and names out in vertex order
+	for (int u = 0; u < n; u++)
+	{
+		graph.ForEachEdge(u, [&](int v, weightType weight)
+		{
+			edgeTargets.push_back(v);
+			edgeWeights.push_back(weight);
+		});
+		rowOffsets.push_back(edgeTargets.size());
+
+		const nameType &name = graph.Name(u);
+		nameBytes.append(name);
+		nameStarts.push_back(nameBytes.size());
+		hasLocation[u] = graph.Location(u, xy[2 * u], xy[2 * u + 1]) ? 1 : 0;
+	}
+
+	//size the hash table to at least twice the vertices so probes stay short
+	unsigned long long slotCount = 1;
+	while (slotCount < 2ULL * n + 1)
+		slotCount *= 2;
+	std::vector<int> table(slotCount, -1);
+	for (int u = 0; u < n; u++)
+	{
+		const char *name = nameBytes.data() + nameStarts[u];
+		std::size_t length = nameStarts[u + 1] - nameStarts[u];
+		unsigned long long slot = Hash(name, length) & (slotCount - 1);
+		bool duplicate = false;
+
+		//the first vertex of a name wins, as in the index of Graph
+		while (table[slot] != -1 && !duplicate)
+		{
+			int v = table[slot];
+			duplicate = nameStarts[v + 1] - nameStarts[v] == length && memcmp(nameBytes.data() + nameStarts[v], name, length) == 0;
+			slot = (slot + 1) & (slotCount - 1);
+		}
+		if (!duplicate)
+			table[slot] = u;
+	}
+
+	SnapshotHeader head;
+	memset(&head, 0, sizeof(head));
+	memcpy(head.magic, "GRAPHSNP", 8);
+	head.version = SNAPSHOT_VERSION;
+	head.byteOrder = SNAPSHOT_BYTE_ORDER;
+	head.weightBytes = sizeof(weightType);
+	head.weightIntegral = std::is_integral<weightType>::value ? 1 : 0;
+	head.vertexCount = n;
+	head.edgeCount = edgeTargets.size();
+	head.nameBytes = nameBytes.size();
+	head.slotCount = slotCount;
+
+	unsigned long long section[9];
+	Layout(head, section);
+	head.bodyBytes = section[8];
+
+	const char *blocks[8] = { (const char *)rowOffsets.data(), (const char *)edgeTargets.data(),
+		(const char *)edgeWeights.data(), (const char *)nameStarts.data(), nameBytes.data(),
+		(const char *)table.data(), hasLocation.data(), (const char *)xy.data() };
+	unsigned long long lengths[8] = { rowOffsets.size() * sizeof(int), edgeTargets.size() * sizeof(int),
+		edgeWeights.size() * sizeof(weightType), nameStarts.size() * sizeof(unsigned long long), nameBytes.size(),
+		table.size() * sizeof(int), hasLocation.size(), xy.size() * sizeof(double) };
+
+	std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+	if (!out)
+		return false;
+
+	//write the sections behind the header, padding each to the next section
+	const char zeros[8] = { 0 };
+	unsigned long long sum = 14695981039346656037ULL;
+	out.write((const char *)&head, sizeof(head));
+	for (int i = 0; i < 8; i++)
+	{
+		out.write(blocks[i], lengths[i]);
+		out.write(zeros, section[i + 1] - section[i] - lengths[i]);
+		sum = Checksum(sum, blocks[i], lengths[i]);
+	}
+
+	//now the checksum is known, fill in the header
+	head.checksum = sum;
+	out.seekp(0);
+	out.write((const char *)&head, sizeof(head));
+	out.close();
+	return !out.fail();
+}
+
+/*******************************************************************************************
+*	Function Name:			Hash
+*	Purpose:				the 64 bit FNV-1a hash of a name
+*	Input Parameters:		const char *name		the first byte of the name
+*							std::size_t length		the length of the name
+*	Return value:			unsigned long long
+********************************************************************************************/
+template <class V, class W>
+unsigned long long MappedGraph<V, W>::Hash(const char *name, std::size_t length)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	for (std::size_t i = 0; i < length; i++)
+	{
+		hash ^= (unsigned char)name[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+/*******************************************************************************************
+*	Function Name:			Checksum
+*	Purpose:				folds a block into a checksum eight bytes at a time, FNV-1a
+*							style, as if the block were padded with zeros to a multiple of
+*							eight bytes. A padded section gives the same checksum as the
+*							section alone, so the writer and Verify agree.
+*	Input Parameters:		unsigned long long sum		the checksum of the blocks before
+*							const char *block			the first byte of the block
+*							std::size_t length			the length of the block
+*	Return value:			unsigned long long	the checksum with the block folded in
+********************************************************************************************/
+template <class V, class W>
+unsigned long long MappedGraph<V, W>::Checksum(unsigned long long sum, const char *block, std::size_t length)
+{
+	std::size_t i = 0;
+	unsigned long long word;
+	for (; i + 8 <= length; i += 8)
+	{
+		memcpy(&word, block + i, 8);
+		sum = (sum ^ word) * 1099511628211ULL;
+	}
+	if (i < length)
+	{
+		word = 0;
+		memcpy(&word, block + i, length - i);
+		sum = (sum ^ word) * 1099511628211ULL;
+	}
+	return sum;
+}
+
+/*******************************************************************************************
+*	Function Name:			Layout
+*	Purpose:				works out where each section starts from the counts in a header
+*	Input Parameters:		const SnapshotHeader &header	the counts of the snapshot
+*							unsigned long long section[9]	set to the offset of each
+*															section from the end of the
+*															header, then the body length
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void MappedGraph<V, W>::Layout(const SnapshotHeader &header, unsigned long long section[9])
+{
+	unsigned long long lengths[8] = { (header.vertexCount + 1) * sizeof(int), header.edgeCount * sizeof(int),
+		header.edgeCount * sizeof(weightType), (header.vertexCount + 1) * sizeof(unsigned long long),
+		header.nameBytes, header.slotCount * sizeof(int), header.vertexCount, 2 * header.vertexCount * sizeof(double) };
+
+	section[0] = 0;
+	for (int i = 0; i < 8; i++)
+		section[i + 1] = section[i] + Pad(lengths[i]);
+}
+
+/*******************************************************************************************
+*	Function Name:			Pad
+*	Purpose:				rounds the length of a section up to a multiple of eight bytes
+*	Input Parameters:		unsigned long long length	the length of the section
+*	Return value:			unsigned long long
+********************************************************************************************/
+template <class V, class W>
+unsigned long long MappedGraph<V, W>::Pad(unsigned long long length)
+{
+	return (length + 7) & ~7ULL;
+}
+
+#endif // !MAPPEDGRAPH_T
@@ -0,0 +1,81 @@
+/**************************************************************************************************
+*
+*   File name :			minheap.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the MinHeap class, implemented in minheap.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		MinHeap
+*
+*	An indexed binary min-heap of vertex indices ordered by a key of type K. Each vertex index
+*	is in the heap at most once and its position is tracked, so a smaller key for a vertex
+*	already in the heap is a decrease-key in O(log n) rather than a second entry.
+*
+*	Private data members:
+*		vector<int> heap	the vertex indices in heap order
+*		vector<int> pos		the position of each vertex index in heap, -1 if not in the heap
+*		vector<K> keys		the current key of each vertex index
+*
+*	Private member functions:
+*		SiftUp				moves an entry toward the root until its parent is not larger
+*		SiftDown			moves an entry toward the leaves until its children are not smaller
+*
+*	Public member functions:
+*		MinHeap				constructor for a MinHeap object
+*		Reset				empties the heap and makes room for vertex indices 0 to n - 1
+*		Clear				empties the heap in time proportional to its size
+*		Empty				tests whether the heap has no entries
+*		Size				the number of entries in the heap
+*		Contains			tests whether a vertex index is in the heap
+*		Push				inserts a vertex index, or lowers its key if it is already in
+*		Top					the vertex index with the smallest key
+*		TopKey				the smallest key
+*		Pop					removes and returns the vertex index with the smallest key
+*		Key					the current key of a vertex index in the heap
+*
+****************************************************************************************************/
+
+#ifndef MINHEAP_H
+#define MINHEAP_H
+#include <vector>
+
+template <class K>
+class MinHeap
+{
+public:
+	MinHeap();		// Constructor
+
+	// Empties the heap and makes room for vertex indices 0 to n - 1. O(size of
+	// the heap) unless n is larger than in any earlier call.
+	void Reset(int n);
+
+	// Empties the heap. O(size of the heap)
+	void Clear();
+
+	bool Empty() const;		// Tests whether the heap has no entries
+	int Size() const;		// Number of entries in the heap
+	bool Contains(int v) const;	// Tests whether vertex index v is in the heap
+
+	// Inserts v with the given key. If v is already in the heap its key is only
+	// lowered; returns true if v was inserted or its key decreased.
+	bool Push(int v, const K &key);
+
+	int Top() const;		// Vertex index with the smallest key
+	K TopKey() const;		// The smallest key
+	int Pop();				// Removes and returns the vertex index with the smallest key
+	K Key(int v) const;		// The current key of vertex index v
+
+private:
+	void SiftUp(int i);
+	void SiftDown(int i);
+	std::vector<int> heap;
+	std::vector<int> pos;
+	std::vector<K> keys;
+};
+#include "minheap.t"
+#endif // !MINHEAP_H
@@ -0,0 +1,238 @@
+/**************************************************************************************************
+*
+*   File name :			minheap.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the functions for the indexed min-heap defined in minheap.h,
+*	used as the priority queue of the shortest path and spanning tree algorithms
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef MINHEAP_T
+#define MINHEAP_T
+
+/*******************************************************************************************
+*	Function Name:			MinHeap()			the constructor
+*	Purpose:				creates an empty heap with room for no vertex indices
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+template <class K>
+MinHeap<K>::MinHeap()
+{
+
+}
+
+/*******************************************************************************************
+*	Function Name:			Reset
+*	Purpose:				empties the heap and makes room for vertex indices 0 to n - 1,
+*							only growing the arrays so a reused heap is not refilled
+*	Input Parameters:		int n	the number of vertex indices
+*	Return value:			void
+********************************************************************************************/
+template <class K>
+void MinHeap<K>::Reset(int n)
+{
+	Clear();
+	if ((int)pos.size() < n)
+	{
+		pos.resize(n, -1);
+		keys.resize(n);
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			Clear
+*	Purpose:				empties the heap, only touching the entries still in it
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class K>
+void MinHeap<K>::Clear()
+{
+	for (unsigned i = 0; i < heap.size(); i++)
+		pos[heap[i]] = -1;
+	heap.clear();
+}
+
+/*******************************************************************************************
+*	Function Name:			Empty
+*	Purpose:				tests whether the heap has no entries
+*	Input Parameters:		none
+*	Return value:			bool
+********************************************************************************************/
+template <class K>
+bool MinHeap<K>::Empty() const
+{
+	return heap.empty();
+}
+
+/*******************************************************************************************
+*	Function Name:			Size
+*	Purpose:				the number of entries in the heap
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class K>
+int MinHeap<K>::Size() const
+{
+	return heap.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			Contains
+*	Purpose:				tests whether a vertex index is in the heap
+*	Input Parameters:		int v	the vertex index
+*	Return value:			bool
+********************************************************************************************/
+template <class K>
+bool MinHeap<K>::Contains(int v) const
+{
+	return pos[v] != -1;
+}
+
+/*******************************************************************************************
+*	Function Name:			Push
+*	Purpose:				inserts a vertex index with a key, or decreases its key if it
+*							is already in the heap and the new key is smaller
+*	Input Parameters:		int v			the vertex index
+*							const K &key	the key of the vertex index
+*	Return value:			bool	true if the vertex was inserted or its key decreased
+********************************************************************************************/
+template <class K>
+bool MinHeap<K>::Push(int v, const K &key)
+{
+	//decrease-key on an entry already in the heap
+	if (pos[v] != -1)
+	{
+		if (!(key < keys[v]))
+			return false;
+		keys[v] = key;
+		SiftUp(pos[v]);
+		return true;
+	}
+
+	//insert at the bottom and move it up
+	keys[v] = key;
+	pos[v] = heap.size();
+	heap.push_back(v);
+	SiftUp(pos[v]);
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			Top
+*	Purpose:				the vertex index with the smallest key
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+template <class K>
+int MinHeap<K>::Top() const
+{
+	return heap.front();
+}
+
+/*******************************************************************************************
+*	Function Name:			TopKey
+*	Purpose:				the smallest key in the heap
+*	Input Parameters:		none
+*	Return value:			K
+********************************************************************************************/
+template <class K>
+K MinHeap<K>::TopKey() const
+{
+	return keys[heap.front()];
+}
+
+/*******************************************************************************************
+*	Function Name:			Pop
+*	Purpose:				removes the vertex index with the smallest key from the heap
+*	Input Parameters:		none
+*	Return value:			int		the removed vertex index
+********************************************************************************************/
+template <class K>
+int MinHeap<K>::Pop()
+{
+	int top = heap.front();
+
+	//move the last entry to the root and let it settle
+	heap.front() = heap.back();
+	pos[heap.front()] = 0;
+	heap.pop_back();
+	pos[top] = -1;
+	if (!heap.empty())
+		SiftDown(0);
+
+	return top;
+}
+
+/*******************************************************************************************
+*	Function Name:			Key
+*	Purpose:				the current key of a vertex index
+*	Input Parameters:		int v	the vertex index
+*	Return value:			K
+********************************************************************************************/
+template <class K>
+K MinHeap<K>::Key(int v) const
+{
+	return keys[v];
+}
+
+/*******************************************************************************************
+*	Function Name:			SiftUp
+*	Purpose:				moves the entry at position i up while it is smaller than its parent
+*	Input Parameters:		int i	the position in the heap
+*	Return value:			void
+********************************************************************************************/
+template <class K>
+void MinHeap<K>::SiftUp(int i)
+{
+	int v = heap[i];
+	while (i > 0)
+	{
+		int parent = (i - 1) / 2;
+		if (!(keys[v] < keys[heap[parent]]))
+			break;
+
+		//pull the parent down into the hole
+		heap[i] = heap[parent];
+		pos[heap[i]] = i;
+		i = parent;
+	}
+	heap[i] = v;
+	pos[v] = i;
+}
+
+/*******************************************************************************************
+*	Function Name:			SiftDown
+*	Purpose:				moves the entry at position i down while a child is smaller
+*	Input Parameters:		int i	the position in the heap
+*	Return value:			void
+********************************************************************************************/
+template <class K>
+void MinHeap<K>::SiftDown(int i)
+{
+	int v = heap[i];
+	int n = heap.size();
+	while (2 * i + 1 < n)
+	{
+		//pick the smaller child
+		int child = 2 * i + 1;
+		if (child + 1 < n && keys[heap[child + 1]] < keys[heap[child]])
+			child++;
+		if (!(keys[heap[child]] < keys[v]))
+			break;
+
+		//pull the child up into the hole
+		heap[i] = heap[child];
+		pos[heap[i]] = i;
+		i = child;
+	}
+	heap[i] = v;
+	pos[v] = i;
+}
+
+#endif // !MINHEAP_T
@@ -0,0 +1,72 @@
+/**************************************************************************************************
+*
+*   File name :			parallel.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the multi-threaded graph algorithms, implemented in parallel.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Like the engines in search.h these work on vertex indices through VertexCount and
+*	ForEachEdge, and only read the graph. The work of each step is spread over the workers of
+*	a ThreadPool; with a pool of size 1 they run on the calling thread alone.
+*
+*	Functions:
+*		DeltaSteppingSearch		single source shortest paths by delta-stepping, relaxing the
+*								light and heavy edges of each bucket in parallel
+*		DirectionOptimizingBFS	level-synchronous breadth first search that switches each level
+*								between expanding the frontier (top-down) and having unvisited
+*								vertices look for a parent in it (bottom-up)
+*		BoruvkaForest			minimum spanning forest by Boruvka's algorithm, each round
+*								finding the lightest edge out of every component in parallel
+*
+****************************************************************************************************/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include "search.h"
+#include "spanning.h"
+#include "threadpool.h"
+
+// Shortest paths from source to every vertex by delta-stepping. Vertices are kept in
+// buckets of distance width delta; edges of weight at most delta (light) are relaxed
+// repeatedly while a bucket fills, and heavier edges once the bucket is settled. dist
+// receives the distance of each vertex (UNREACHABLE if not reachable) and prev the
+// previous vertex on a shortest path. delta <= 0 picks the largest edge weight over
+// the average degree. Edge weights must not be negative.
+template <class Adj>
+void DeltaSteppingSearch(const Adj &graph, int source, double delta, std::vector<double> &dist,
+	std::vector<int> &prev, ThreadPool &pool);
+
+// Breadth first search from source that finds the hop distance of every vertex.
+// reverse must have the same vertices as graph with every edge reversed, such as
+// CSRGraph::Transpose, or be graph itself if graph is undirected; it must also
+// provide ForEachEdgeUntil, and graph must provide Degree. A level is expanded top-down while the frontier is
+// small and bottom-up once the edges leaving the frontier outnumber the edges left
+// to check over 14, going back when the frontier falls under V / 24. depth receives
+// the number of edges from source to each vertex (-1 if not reachable) and parent
+// the vertex each one was reached from. Frontiers and visited marks are bitmaps.
+template <class Adj, class RevAdj>
+void DirectionOptimizingBFS(const Adj &graph, const RevAdj &reverse, int source, std::vector<int> &depth,
+	std::vector<int> &parent, ThreadPool &pool);
+
+// Minimum spanning forest of the whole graph by Boruvka's algorithm, covering every
+// component, connected or not. Like KruskalForest each edge counts as undirected and
+// tree receives the forest edges, ordered by round. Returns the total weight. Each
+// round every component picks its lightest outgoing edge, ties broken by position so
+// no cycle can form, and components are merged along those edges without locks.
+// Edges inside a component are dropped between rounds. O(log V) rounds of O(V + E) work.
+template <class Adj>
+double BoruvkaForest(const Adj &graph, std::vector<TreeEdge> &tree, ThreadPool &pool);
+
+#include "parallel.t"
+#endif // !PARALLEL_H
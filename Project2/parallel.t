@@ -0,0 +1,489 @@
+/**************************************************************************************************
+*
+*   File name :			parallel.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the multi-threaded graph algorithms defined in parallel.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef PARALLEL_T
+#define PARALLEL_T
+
+/*******************************************************************************************
+*	Function Name:			DeltaSteppingSearch
+*	Purpose:				delta-stepping shortest paths from a source vertex. The smallest
+*							non-empty bucket is emptied in rounds: all of its vertices relax
+*							their light edges in parallel, which may refill the bucket, and
+*							once it stays empty every vertex removed from it relaxes its
+*							heavy edges, which only reach later buckets. A relaxation that
+*							improves a distance takes a lock on that vertex's stripe, so the
+*							distance and previous vertex always change together.
+*	Input Parameters:		const Adj &graph		the graph to search
+*							int source				index of the starting vertex
+*							double delta			the bucket width, <= 0 to pick one
+*							vector<double> &dist	filled with the distance to each vertex
+*							vector<int> &prev		filled with the previous vertex on each path
+*							ThreadPool &pool		the workers to use
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void DeltaSteppingSearch(const Adj &graph, int source, double delta, std::vector<double> &dist,
+	std::vector<int> &prev, ThreadPool &pool)
+{
+	const int STRIPES = 1024;					//number of locks shared out among the vertices
+	int n = graph.VertexCount();
+	std::unique_ptr<std::atomic<double>[]> best(new std::atomic<double>[n]);
+	std::unique_ptr<std::mutex[]> locks(new std::mutex[STRIPES]);
+	std::map<long long, std::vector<int> > buckets;		//bucket number to the vertices placed in it
+	std::vector<std::vector<int> > reached(pool.Size());	//vertices each worker improved in a round
+	std::vector<char> removed(n, 0);			//whether a vertex is in the current bucket's removed set
+	std::vector<int> frontier;					//vertices being expanded this round
+	std::vector<int> settled;					//vertices removed from the current bucket
+
+	prev.assign(n, -1);
+	for (int v = 0; v < n; v++)
+		best[v].store(UNREACHABLE, std::memory_order_relaxed);
+
+	//pick the bucket width from the largest weight and the average degree
+	if (delta <= 0)
+	{
+		double maxWeight = 0;
+		long long edges = 0;
+		for (int u = 0; u < n; u++)
+		{
+			graph.ForEachEdge(u, [&](int, double weight)
+			{
+				if (weight > maxWeight)
+					maxWeight = weight;
+				edges++;
+			});
+		}
+		delta = edges == 0 ? 1 : maxWeight * n / edges;
+		if (delta <= 0)
+			delta = 1;
+	}
+
+	//relaxes one edge into next at distance d from curr, remembering next if it improved
+	auto relax = [&](int worker, int curr, int next, double d)
+	{
+		if (!(d < best[next].load(std::memory_order_relaxed)))
+			return;
+		std::lock_guard<std::mutex> guard(locks[next % STRIPES]);
+		if (d < best[next].load(std::memory_order_relaxed))
+		{
+			best[next].store(d, std::memory_order_relaxed);
+			prev[next] = curr;
+			reached[worker].push_back(next);
+		}
+	};
+
+	//expands every vertex in frontier over its light or its heavy edges, then files the improved vertices into their buckets
+	auto expand = [&](bool light)
+	{
+		auto body = [&](int worker, int k)
+		{
+			int curr = frontier[k];
+			double currDist = best[curr].load(std::memory_order_relaxed);
+			graph.ForEachEdge(curr, [&](int next, double weight)
+			{
+				if ((weight <= delta) == light)
+					relax(worker, curr, next, currDist + weight);
+			});
+		};
+
+		//waking the workers costs more than a small round does
+		if (frontier.size() < 256)
+		{
+			for (unsigned k = 0; k < frontier.size(); k++)
+				body(0, k);
+		}
+		else
+			pool.ParallelFor(frontier.size(), 64, body);
+
+		for (unsigned w = 0; w < reached.size(); w++)
+		{
+			for (unsigned k = 0; k < reached[w].size(); k++)
+			{
+				int v = reached[w][k];
+				buckets[(long long)(best[v].load(std::memory_order_relaxed) / delta)].push_back(v);
+			}
+			reached[w].clear();
+		}
+	};
+
+	best[source].store(0, std::memory_order_relaxed);
+	buckets[0].push_back(source);
+
+	while (!buckets.empty())
+	{
+		long long current = buckets.begin()->first;
+		settled.clear();
+
+		//empty the bucket, relaxing light edges until it is not refilled
+		while (buckets.count(current) != 0)
+		{
+			frontier.clear();
+			std::vector<int> &members = buckets[current];
+			for (unsigned k = 0; k < members.size(); k++)
+			{
+				//a vertex is filed again each time it improves; skip the copies that moved to another bucket
+				int v = members[k];
+				if ((long long)(best[v].load(std::memory_order_relaxed) / delta) != current)
+					continue;
+				frontier.push_back(v);
+				if (!removed[v])
+				{
+					removed[v] = 1;
+					settled.push_back(v);
+				}
+			}
+			buckets.erase(current);
+			expand(true);
+		}
+
+		//the bucket is final, so its heavy edges are relaxed once
+		frontier.swap(settled);
+		for (unsigned k = 0; k < frontier.size(); k++)
+			removed[frontier[k]] = 0;
+		expand(false);
+	}
+
+	dist.resize(n);
+	for (int v = 0; v < n; v++)
+		dist[v] = best[v].load(std::memory_order_relaxed);
+}
+
+/*******************************************************************************************
+*	Function Name:			DirectionOptimizingBFS
+*	Purpose:				breadth first search one level at a time. Top-down, each
+*							frontier vertex claims its unvisited neighbours by setting their
+*							visited bit, and the worker that sets a bit becomes that vertex's
+*							discoverer. Bottom-up, each unvisited vertex scans its incoming
+*							edges and stops at the first one from the frontier, which skips
+*							most of the edges once the frontier covers much of the graph.
+*	Input Parameters:		const Adj &graph			the graph to search
+*							const RevAdj &reverse		the graph with every edge reversed
+*							int source					index of the starting vertex
+*							vector<int> &depth			filled with the hop distance of each vertex
+*							vector<int> &parent			filled with the parent of each vertex
+*							ThreadPool &pool			the workers to use
+*	Return value:			void
+********************************************************************************************/
+template <class Adj, class RevAdj>
+void DirectionOptimizingBFS(const Adj &graph, const RevAdj &reverse, int source, std::vector<int> &depth,
+	std::vector<int> &parent, ThreadPool &pool)
+{
+	const int ALPHA = 14;		//go bottom-up when frontier edges exceed unchecked edges / ALPHA
+	const int BETA = 24;		//go back top-down when the frontier is under V / BETA vertices
+	int n = graph.VertexCount();
+	int words = (n + 63) / 64;
+	std::unique_ptr<std::atomic<uint64_t>[]> visited(new std::atomic<uint64_t>[words]);
+	std::unique_ptr<std::atomic<uint64_t>[]> inFrontier(new std::atomic<uint64_t>[words]);
+	std::vector<std::vector<int> > found(pool.Size());	//vertices each worker discovered this level
+	std::vector<int> frontier;
+	long long frontierEdges;		//edges leaving the frontier
+	long long uncheckedEdges = 0;	//edges leaving vertices not yet visited
+	bool bottomUp = false;
+	int level = 0;
+
+	depth.assign(n, -1);
+	parent.assign(n, -1);
+	for (int w = 0; w < words; w++)
+	{
+		visited[w].store(0, std::memory_order_relaxed);
+		inFrontier[w].store(0, std::memory_order_relaxed);
+	}
+	for (int v = 0; v < n; v++)
+		uncheckedEdges += graph.Degree(v);
+
+	//start from the source
+	visited[source / 64].store(uint64_t(1) << (source % 64), std::memory_order_relaxed);
+	depth[source] = 0;
+	frontier.push_back(source);
+	frontierEdges = graph.Degree(source);
+	uncheckedEdges -= frontierEdges;
+
+	while (!frontier.empty())
+	{
+		//choose the direction of this level
+		if (!bottomUp && frontierEdges > uncheckedEdges / ALPHA)
+			bottomUp = true;
+		else if (bottomUp && (long long)frontier.size() < n / BETA)
+			bottomUp = false;
+		level++;
+
+		if (!bottomUp)
+		{
+			pool.ParallelFor(frontier.size(), 256, [&](int worker, int k)
+			{
+				int curr = frontier[k];
+				graph.ForEachEdge(curr, [&](int next, double)
+				{
+					uint64_t bit = uint64_t(1) << (next % 64);
+					if (visited[next / 64].load(std::memory_order_relaxed) & bit)
+						return;
+
+					//only the worker that sets the bit records the vertex
+					if (!(visited[next / 64].fetch_or(bit, std::memory_order_relaxed) & bit))
+					{
+						parent[next] = curr;
+						depth[next] = level;
+						found[worker].push_back(next);
+					}
+				});
+			});
+		}
+		else
+		{
+			for (unsigned k = 0; k < frontier.size(); k++)
+				inFrontier[frontier[k] / 64].fetch_or(uint64_t(1) << (frontier[k] % 64), std::memory_order_relaxed);
+
+			//each worker takes whole blocks of vertices, so no two workers look at one vertex
+			pool.ParallelFor(n, 4096, [&](int worker, int next)
+			{
+				uint64_t bit = uint64_t(1) << (next % 64);
+				if (visited[next / 64].load(std::memory_order_relaxed) & bit)
+					return;
+
+				reverse.ForEachEdgeUntil(next, [&](int curr, double)
+				{
+					if (!(inFrontier[curr / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (curr % 64))))
+						return false;
+					parent[next] = curr;
+					depth[next] = level;
+					found[worker].push_back(next);
+					return true;
+				});
+			});
+
+			//mark the new level visited and clear the frontier bitmap for the next bottom-up level
+			for (unsigned w = 0; w < found.size(); w++)
+			{
+				for (unsigned k = 0; k < found[w].size(); k++)
+					visited[found[w][k] / 64].fetch_or(uint64_t(1) << (found[w][k] % 64), std::memory_order_relaxed);
+			}
+			for (unsigned k = 0; k < frontier.size(); k++)
+				inFrontier[frontier[k] / 64].store(0, std::memory_order_relaxed);
+		}
+
+		//the vertices found this level are the next frontier
+		frontier.clear();
+		frontierEdges = 0;
+		for (unsigned w = 0; w < found.size(); w++)
+		{
+			for (unsigned k = 0; k < found[w].size(); k++)
+			{
+				frontier.push_back(found[w][k]);
+				frontierEdges += graph.Degree(found[w][k]);
+			}
+			found[w].clear();
+		}
+		uncheckedEdges -= frontierEdges;
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			BoruvkaForest
+*	Purpose:				Boruvka's minimum spanning forest. The edges are copied into flat
+*							arrays, then each round:
+*							 - every edge offers itself to the components at both ends,
+*							   which keep the lightest offer with a compare-and-swap
+*							 - each component hooks onto the component across its edge.
+*							   Two components that chose the same edge point at each
+*							   other, and the smaller index becomes the root
+*							 - hooks are shortcut to their roots by pointer jumping and
+*							   every vertex takes its new root as its component
+*							 - edges inside one component are filtered out
+*							A component with no outgoing edge is finished and drops out.
+*	Input Parameters:		const Adj &graph			the graph
+*							vector<TreeEdge> &tree		filled with the forest edges
+*							ThreadPool &pool			the workers to use
+*	Return value:			double	the total weight of the forest
+********************************************************************************************/
+template <class Adj>
+double BoruvkaForest(const Adj &graph, std::vector<TreeEdge> &tree, ThreadPool &pool)
+{
+	const int GRAIN = 2048;		//edges or vertices handed to a worker at a time
+	int n = graph.VertexCount();
+	std::vector<int> offsets(n + 1, 0);			//where each vertex's edges start in the arrays
+	std::vector<int> from, to, kept;			//the edges still between components, and how many of each chunk survive
+	std::vector<double> weight;
+	std::vector<int> nextFrom, nextTo;			//the edges kept by the filter
+	std::vector<double> nextWeight;
+	std::vector<int> comp(n);					//the root of each vertex's component
+	std::vector<int> roots(n);					//the components still growing
+	std::vector<int> chosen(n, -1);				//the edge each component joined the forest by this round
+	std::unique_ptr<std::atomic<int>[]> best(new std::atomic<int>[n]);	//lightest edge out of each component
+	std::unique_ptr<std::atomic<int>[]> hook(new std::atomic<int>[n]);	//the component each component merges into
+	double total = 0;
+
+	//lay the edges out in flat arrays, each vertex's edges after the previous vertex's
+	pool.ParallelFor(n, GRAIN, [&](int, int u)
+	{
+		int count = 0;
+		graph.ForEachEdge(u, [&](int, double) { count++; });
+		offsets[u + 1] = count;
+	});
+	for (int u = 0; u < n; u++)
+		offsets[u + 1] += offsets[u];
+	from.resize(offsets[n]);
+	to.resize(offsets[n]);
+	weight.resize(offsets[n]);
+	pool.ParallelFor(n, GRAIN, [&](int, int u)
+	{
+		int e = offsets[u];
+		graph.ForEachEdge(u, [&](int v, double w)
+		{
+			from[e] = u;
+			to[e] = v;
+			weight[e] = w;
+			e++;
+		});
+	});
+
+	for (int v = 0; v < n; v++)
+	{
+		comp[v] = v;
+		roots[v] = v;
+	}
+
+	//whether edge a is lighter than edge b; positions break ties so the order is strict
+	auto lighter = [&](int a, int b)
+	{
+		return weight[a] < weight[b] || (weight[a] == weight[b] && a < b);
+	};
+
+	tree.clear();
+	while (!roots.empty() && !from.empty())
+	{
+		int m = from.size();
+		int r = roots.size();
+
+		//each edge between two components offers itself to both
+		pool.ParallelFor(r, GRAIN, [&](int, int k)
+		{
+			best[roots[k]].store(-1, std::memory_order_relaxed);
+		});
+		pool.ParallelFor(m, GRAIN, [&](int, int e)
+		{
+			int ends[2] = { comp[from[e]], comp[to[e]] };
+			if (ends[0] == ends[1])
+				return;
+			for (int side = 0; side < 2; side++)
+			{
+				std::atomic<int> &slot = best[ends[side]];
+				int current = slot.load(std::memory_order_relaxed);
+				while ((current == -1 || lighter(e, current)) &&
+					!slot.compare_exchange_weak(current, e, std::memory_order_relaxed))
+				{
+				}
+			}
+		});
+
+		//hook each component onto the one across its lightest edge
+		pool.ParallelFor(r, GRAIN, [&](int, int k)
+		{
+			int c = roots[k];
+			int e = best[c].load(std::memory_order_relaxed);
+			if (e == -1)
+				hook[c].store(c, std::memory_order_relaxed);
+			else
+				hook[c].store(comp[from[e]] == c ? comp[to[e]] : comp[from[e]], std::memory_order_relaxed);
+		});
+
+		//a pair that chose the same edge points at each other; the smaller one becomes the root
+		pool.ParallelFor(r, GRAIN, [&](int, int k)
+		{
+			int c = roots[k];
+			int e = best[c].load(std::memory_order_relaxed);
+			int d = hook[c].load(std::memory_order_relaxed);
+			chosen[c] = e;
+			if (e != -1 && c < d && hook[d].load(std::memory_order_relaxed) == c)
+			{
+				hook[c].store(c, std::memory_order_relaxed);
+				chosen[c] = -1;
+			}
+		});
+
+		//shortcut every hook to its root
+		std::atomic<bool> changed(true);
+		while (changed.load())
+		{
+			changed.store(false);
+			pool.ParallelFor(r, GRAIN, [&](int, int k)
+			{
+				int c = roots[k];
+				int up = hook[c].load(std::memory_order_relaxed);
+				int top = hook[up].load(std::memory_order_relaxed);
+				if (up != top)
+				{
+					hook[c].store(top, std::memory_order_relaxed);
+					changed.store(true, std::memory_order_relaxed);
+				}
+			});
+		}
+		pool.ParallelFor(n, GRAIN, [&](int, int v)
+		{
+			comp[v] = hook[comp[v]].load(std::memory_order_relaxed);
+		});
+
+		//record the chosen edges, and keep the roots that can still grow
+		int live = 0;
+		for (int k = 0; k < r; k++)
+		{
+			int c = roots[k];
+			if (chosen[c] != -1)
+			{
+				TreeEdge edge = { from[chosen[c]], to[chosen[c]], weight[chosen[c]] };
+				tree.push_back(edge);
+				total += edge.weight;
+			}
+			if (hook[c].load(std::memory_order_relaxed) == c && best[c].load(std::memory_order_relaxed) != -1)
+				roots[live++] = c;
+		}
+		roots.resize(live);
+
+		//drop the edges that now lie inside one component: count the survivors of each chunk, then copy them
+		int chunks = (m + GRAIN - 1) / GRAIN;
+		kept.assign(chunks + 1, 0);
+		pool.ParallelFor(chunks, 1, [&](int, int chunk)
+		{
+			int end = (chunk + 1) * GRAIN < m ? (chunk + 1) * GRAIN : m;
+			for (int e = chunk * GRAIN; e < end; e++)
+			{
+				if (comp[from[e]] != comp[to[e]])
+					kept[chunk + 1]++;
+			}
+		});
+		for (int chunk = 0; chunk < chunks; chunk++)
+			kept[chunk + 1] += kept[chunk];
+		nextFrom.resize(kept[chunks]);
+		nextTo.resize(kept[chunks]);
+		nextWeight.resize(kept[chunks]);
+		pool.ParallelFor(chunks, 1, [&](int, int chunk)
+		{
+			int end = (chunk + 1) * GRAIN < m ? (chunk + 1) * GRAIN : m;
+			int out = kept[chunk];
+			for (int e = chunk * GRAIN; e < end; e++)
+			{
+				if (comp[from[e]] != comp[to[e]])
+				{
+					nextFrom[out] = from[e];
+					nextTo[out] = to[e];
+					nextWeight[out] = weight[e];
+					out++;
+				}
+			}
+		});
+		from.swap(nextFrom);
+		to.swap(nextTo);
+		weight.swap(nextWeight);
+	}
+	return total;
+}
+
+#endif // !PARALLEL_T
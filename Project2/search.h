@@ -0,0 +1,146 @@
+/**************************************************************************************************
+*
+*   File name :			search.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the graph search engines, implemented in search.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	The engines work on vertex indices rather than vertex names, and on any graph type Adj that
+*	provides the following public member functions:
+*		int VertexCount()				the number of vertices, indexed 0 to VertexCount() - 1
+*		void ForEachEdge(int u, F visit)	calls visit(int target, weight) for each edge leaving u
+*		bool ForEachEdgeUntil(int u, F visit)	the same, until visit returns true (FordSearch)
+*		int Degree(int u)				the number of edges leaving u (DirectionOptimizingBFS)
+*
+*	The engines only read the graph. Their results are left in the Workspace passed to them,
+*	which each engine starts a new query on, so concurrent searches of one graph only need a
+*	Workspace each.
+*
+*	Each engine also takes an optional visitor (visitor.h) whose hooks are called from its
+*	main loop. Without one the engine uses a NullVisitor, whose empty hooks compile away.
+*
+*	Functions:
+*		DijkstraSearch		Dijkstra's algorithm on an indexed min-heap with decrease-key,
+*							stopping as soon as the target vertex is settled
+*		AStarSearch			Dijkstra's algorithm with each vertex's key raised by a lower
+*							bound on its distance to the target, from a heuristic policy
+*		BidirectionalSearch	Dijkstra's algorithm from the source forwards and from the target
+*							backwards at once, stopping when the two searches prove the
+*							shortest distance
+*		BreadthFirstSearch	breadth first visiting order and parents from a source vertex
+*		DepthFirstSearch	depth first visiting order, parents, and discovery and finish
+*							times from a source vertex, using an explicit stack instead of
+*							recursion
+*		PrimSearch			Prim's algorithm on an indexed min-heap for the minimum spanning
+*							tree of the source vertex's component
+*		FordSearch			Ford's label-correcting algorithm for shortest paths with
+*							negative edge weights, stopping at a negative cycle
+*		PreviousCycle		finds a cycle among the previous vertices of a search
+*
+****************************************************************************************************/
+
+#ifndef SEARCH_H
+#define SEARCH_H
+#include <vector>
+#include <deque>
+#include <utility>
+#include <algorithm>
+#include "minheap.h"
+#include "workspace.h"
+#include "visitor.h"
+#include "heuristic.h"
+
+// Finds the shortest distances from source using Dijkstra's algorithm. Afterwards
+// ws.Dist is the distance of each vertex and ws.Prev the previous vertex index on its
+// shortest path (-1 for the source and unreached vertices). If target is a vertex
+// index the search stops once target is settled, otherwise (-1) every reachable
+// vertex is settled. Returns the distance to target, UNREACHABLE if there is no path.
+// Runs in O((V + E) log V) for non-negative edge weights. The visitor's Settle is
+// called for each popped vertex and Relax for each edge that shortens a distance.
+template <class Adj>
+double DijkstraSearch(const Adj &graph, int source, int target, Workspace &ws);
+template <class Adj, class Visitor>
+double DijkstraSearch(const Adj &graph, int source, int target, Workspace &ws, Visitor &visitor);
+
+// Point to point shortest distance by A*. Like DijkstraSearch with a target, except
+// that a vertex is keyed by its distance plus estimate(v, target), so vertices that
+// head away from the target wait. estimate is a heuristic (heuristic.h); it must
+// never overestimate, and with ZeroHeuristic the search is Dijkstra's. A vertex is
+// queued again if its distance improves after it was expanded, so an estimate that
+// is a lower bound without being consistent still gives the shortest distance.
+// Leaves ws.Dist and ws.Prev as DijkstraSearch does for the vertices it reaches and
+// returns the distance to target, UNREACHABLE if there is no path.
+template <class Adj, class Heuristic>
+double AStarSearch(const Adj &graph, int source, int target, Workspace &ws, const Heuristic &estimate);
+
+// Point to point shortest distance and path by bidirectional Dijkstra. reverse must
+// have the same vertices as graph with every edge reversed, such as CSRGraph::Transpose,
+// or be graph itself if graph is undirected. The search with the smaller heap takes the
+// next step, and both stop once the smallest keys of the two heaps add up to at least
+// the shortest path seen through a vertex labeled by both. path receives the vertex
+// indices from source to target, empty if there is none. forward and backward hold the
+// two searches. Returns the distance, UNREACHABLE if there is no path.
+template <class Adj, class RevAdj>
+double BidirectionalSearch(const Adj &graph, const RevAdj &reverse, int source, int target,
+	std::vector<int> &path, Workspace &forward, Workspace &backward);
+
+// Breadth first search from source. order receives the vertex indices in the order
+// they are visited; ws.Prev is the vertex each one was reached from and ws.Mark is 1
+// for each visited vertex. O(V + E). The visitor's Discover is called as each vertex
+// is queued and Examine as it is dequeued.
+template <class Adj>
+void BreadthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws);
+template <class Adj, class Visitor>
+void BreadthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws, Visitor &visitor);
+
+// Depth first search from source, visiting the edges of each vertex in order. order
+// receives the vertex indices in the order they are discovered; ws.Prev is the vertex
+// each one was discovered from. Discovery and finish share one clock that ticks at
+// each event: ws.Dist is the time a vertex was discovered and ws.Cost the time all of
+// its edges were done. Uses an explicit stack, so any depth is safe. O(V + E)
+// The visitor's Discover and Finish are called at those two times.
+template <class Adj>
+void DepthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws);
+template <class Adj, class Visitor>
+void DepthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws, Visitor &visitor);
+
+// Prim's algorithm from source over the edges leaving each vertex. ws.Prev is the
+// tree vertex each vertex was connected from and ws.Cost the weight of that edge
+// (UNREACHABLE for vertices outside the source's component); ws.Dist is the length
+// of the path to each vertex through the tree from source. Returns the total
+// weight of the tree. O((V + E) log V). The visitor's Settle is called as each vertex
+// joins the tree, Relax when a cheaper edge to a vertex outside it is found, and
+// Finish once the edges of the vertex that joined have all been relaxed.
+template <class Adj>
+double PrimSearch(const Adj &graph, int source, Workspace &ws);
+template <class Adj, class Visitor>
+double PrimSearch(const Adj &graph, int source, Workspace &ws, Visitor &visitor);
+
+// Ford's label-correcting algorithm from source (the queue-based Bellman-Ford, or
+// SPFA), which allows negative edge weights. A vertex is queued again whenever its
+// distance improves and it is not already in the queue (ws.Mark). A vertex whose
+// distance drops below the front of the queue goes to the front (small label first),
+// and vertices above the queue's average distance are passed over to the back (large
+// label last). Leaves the distances in ws.Dist, previous vertices in ws.Prev, and the
+// number of edges on each vertex's path in ws.Cost. A path of V or more edges means a
+// negative cycle is reachable from source; the search then stops as soon as the cycle
+// shows up among the previous vertices, puts its vertices in cycle in edge order, and
+// returns false. Otherwise cycle is left empty and it returns true. O(VE) either way.
+// The visitor's Discover is called as a vertex is queued, Examine as it is dequeued,
+// and Relax for each edge that shortens a distance.
+template <class Adj>
+bool FordSearch(const Adj &graph, int source, Workspace &ws, std::vector<int> &cycle);
+template <class Adj, class Visitor>
+bool FordSearch(const Adj &graph, int source, Workspace &ws, std::vector<int> &cycle, Visitor &visitor);
+
+// Looks for a cycle by following ws.Prev from start. If there is one its vertices are
+// put in cycle in edge order and it returns true. O(V) with constant extra space.
+bool PreviousCycle(const Workspace &ws, int start, std::vector<int> &cycle);
+
+#include "search.t"
+#endif // !SEARCH_H
@@ -0,0 +1,521 @@
+/**************************************************************************************************
+*
+*   File name :			search.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the graph search engines defined in search.h. The engines
+*	only compute; printing trace information is left to the Graph member functions that use them.
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef SEARCH_T
+#define SEARCH_T
+
+/*******************************************************************************************
+*	Function Name:			DijkstraSearch
+*	Purpose:				Dijkstra's algorithm from a source vertex. Each vertex is held
+*							in the heap at most once and a shorter distance decreases its
+*							key, so a vertex is expanded once with non-negative weights.
+*							With a target the search ends as soon as the target is popped,
+*							since its distance can no longer improve.
+*	Input Parameters:		const Adj &graph	the graph to search
+*							int source			index of the starting vertex
+*							int target			index of the ending vertex, -1 for all
+*							Workspace &ws		receives the distances and previous vertices
+*							Visitor &visitor	told of each settled vertex and relaxed edge
+*	Return value:			double	the distance to target, UNREACHABLE if there is no path
+********************************************************************************************/
+template <class Adj, class Visitor>
+double DijkstraSearch(const Adj &graph, int source, int target, Workspace &ws, Visitor &visitor)
+{
+	ws.Begin(graph.VertexCount());
+	MinHeap<double> &heap = ws.Heap();		//vertices reached but not yet settled, keyed by distance
+
+	//start at the source
+	ws.SetDist(source, 0);
+	heap.Push(source, 0);
+
+	while (!heap.Empty())
+	{
+		//settle the closest vertex
+		int curr = heap.Pop();
+		visitor.Settle(curr, ws);
+		if (curr == target)
+			break;
+
+		double currDist = ws.Dist(curr);
+
+		//relax each edge leaving it
+		graph.ForEachEdge(curr, [&](int next, double cost)
+		{
+			if (currDist + cost < ws.Dist(next))
+			{
+				ws.SetDist(next, currDist + cost);
+				ws.SetPrev(next, curr);
+				heap.Push(next, currDist + cost);
+				visitor.Relax(curr, next, cost, ws);
+			}
+		});
+	}
+
+	if (target == -1)
+		return 0;
+	return ws.Dist(target);
+}
+
+/*******************************************************************************************
+*	Function Name:			AStarSearch
+*	Purpose:				A* search from a source vertex to a target vertex. The heap is
+*							keyed by the distance so far plus the heuristic's estimate of
+*							the rest, and the search ends when the target is popped.
+*	Input Parameters:		const Adj &graph				the graph to search
+*							int source						index of the starting vertex
+*							int target						index of the ending vertex
+*							Workspace &ws					receives the distances and previous
+*															vertices
+*							const Heuristic &estimate		the lower bound to the target
+*	Return value:			double	the distance to target, UNREACHABLE if there is no path
+********************************************************************************************/
+template <class Adj, class Heuristic>
+double AStarSearch(const Adj &graph, int source, int target, Workspace &ws, const Heuristic &estimate)
+{
+	ws.Begin(graph.VertexCount());
+	MinHeap<double> &heap = ws.Heap();		//vertices reached but not yet expanded, keyed by distance plus estimate
+
+	ws.SetDist(source, 0);
+	heap.Push(source, estimate(source, target));
+
+	while (!heap.Empty())
+	{
+		int curr = heap.Pop();
+		if (curr == target)
+			break;
+
+		double currDist = ws.Dist(curr);
+		graph.ForEachEdge(curr, [&](int next, double cost)
+		{
+			if (currDist + cost < ws.Dist(next))
+			{
+				ws.SetDist(next, currDist + cost);
+				ws.SetPrev(next, curr);
+				heap.Push(next, currDist + cost + estimate(next, target));
+			}
+		});
+	}
+
+	return ws.Dist(target);
+}
+
+/*******************************************************************************************
+*	Function Name:			BidirectionalStep
+*	Purpose:				settles the closest vertex of one side of a bidirectional search
+*							and relaxes its edges, noting any vertex the other side has
+*							also labeled that gives a shorter path
+*	Input Parameters:		const Adj &graph	the edges this side follows
+*							Workspace &ws		this side's search
+*							Workspace &other	the other side's search
+*							double &best		the shortest path through both sides so far
+*							int &meet			the vertex that path goes through
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void BidirectionalStep(const Adj &graph, Workspace &ws, const Workspace &other, double &best, int &meet)
+{
+	int curr = ws.Heap().Pop();
+	double currDist = ws.Dist(curr);
+
+	graph.ForEachEdge(curr, [&](int next, double cost)
+	{
+		double d = currDist + cost;
+		if (d < ws.Dist(next))
+		{
+			ws.SetDist(next, d);
+			ws.SetPrev(next, curr);
+			ws.Heap().Push(next, d);
+		}
+		if (d + other.Dist(next) < best)
+		{
+			best = d + other.Dist(next);
+			meet = next;
+		}
+	});
+}
+
+/*******************************************************************************************
+*	Function Name:			BidirectionalSearch
+*	Purpose:				bidirectional Dijkstra's algorithm. Each side is an ordinary
+*							Dijkstra search with its own workspace and heap. Any path
+*							still to be found is at least as long as the two smallest heap
+*							keys added together, so the search ends once they reach the best
+*							path found through a vertex both sides have labeled.
+*	Input Parameters:		const Adj &graph			the graph to search
+*							const RevAdj &reverse		the graph with every edge reversed
+*							int source					index of the starting vertex
+*							int target					index of the ending vertex
+*							vector<int> &path			filled with the shortest path
+*							Workspace &forward			the search from source
+*							Workspace &backward			the search from target
+*	Return value:			double	the distance to target, UNREACHABLE if there is no path
+********************************************************************************************/
+template <class Adj, class RevAdj>
+double BidirectionalSearch(const Adj &graph, const RevAdj &reverse, int source, int target,
+	std::vector<int> &path, Workspace &forward, Workspace &backward)
+{
+	MinHeap<double> &ahead = forward.Heap();
+	MinHeap<double> &behind = backward.Heap();
+	double best = UNREACHABLE;		//the shortest path through both sides so far
+	int meet = -1;					//the vertex that path goes through
+
+	forward.Begin(graph.VertexCount());
+	backward.Begin(graph.VertexCount());
+	path.clear();
+
+	forward.SetDist(source, 0);
+	ahead.Push(source, 0);
+	backward.SetDist(target, 0);
+	behind.Push(target, 0);
+	if (source == target)
+	{
+		best = 0;
+		meet = source;
+	}
+
+	while (!ahead.Empty() && !behind.Empty() && ahead.TopKey() + behind.TopKey() < best)
+	{
+		//grow the side with less work waiting
+		if (ahead.Size() <= behind.Size())
+			BidirectionalStep(graph, forward, backward, best, meet);
+		else
+			BidirectionalStep(reverse, backward, forward, best, meet);
+	}
+
+	if (meet == -1)
+		return UNREACHABLE;
+
+	//source to the meeting vertex comes from the forward side, backwards, and the rest from the backward side
+	for (int at = meet; at != -1; at = forward.Prev(at))
+		path.push_back(at);
+	std::reverse(path.begin(), path.end());
+	for (int at = backward.Prev(meet); at != -1; at = backward.Prev(at))
+		path.push_back(at);
+	return best;
+}
+
+/*******************************************************************************************
+*	Function Name:			BreadthFirstSearch
+*	Purpose:				breadth first search from a source vertex, marking vertices
+*							when they are queued so each is queued once
+*	Input Parameters:		const Adj &graph	the graph to search
+*							int source			index of the starting vertex
+*							vector<int> &order	filled with the visiting order
+*							Workspace &ws		receives the visited marks and parents
+*							Visitor &visitor	told of each queued and dequeued vertex
+*	Return value:			void
+********************************************************************************************/
+template <class Adj, class Visitor>
+void BreadthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws, Visitor &visitor)
+{
+	ws.Begin(graph.VertexCount());
+	order.clear();
+
+	//the order vector doubles as the queue; head is the next vertex to expand
+	ws.SetMark(source, 1);
+	order.push_back(source);
+	visitor.Discover(source, ws);
+	for (unsigned head = 0; head < order.size(); head++)
+	{
+		int curr = order[head];
+		visitor.Examine(curr, ws);
+		graph.ForEachEdge(curr, [&](int next, double)
+		{
+			if (!ws.Mark(next))
+			{
+				ws.SetMark(next, 1);
+				ws.SetPrev(next, curr);
+				order.push_back(next);
+				visitor.Discover(next, ws);
+			}
+		});
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			DepthFirstSearch
+*	Purpose:				depth first search from a source vertex without recursion. When
+*							a vertex is discovered a finish entry for it is pushed, then its
+*							unvisited neighbours in reverse so they are explored in list
+*							order. The finish entry is popped once everything above it, the
+*							vertex's whole subtree, is done, which gives its finish time.
+*	Input Parameters:		const Adj &graph	the graph to search
+*							int source			index of the starting vertex
+*							vector<int> &order	filled with the discovery order
+*							Workspace &ws		receives the parents and the discovery and
+*												finish times
+*							Visitor &visitor	told of each discovered and finished vertex
+*	Return value:			void
+********************************************************************************************/
+template <class Adj, class Visitor>
+void DepthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws, Visitor &visitor)
+{
+	std::vector<std::pair<int, int> > stack;	//(vertex, vertex it was reached from); a vertex v stored as -v - 1 is its finish entry
+	std::vector<int> edges;						//edges of the current vertex, reversed onto the stack
+	int clock = 0;
+
+	ws.Begin(graph.VertexCount());
+	order.clear();
+
+	stack.push_back(std::make_pair(source, -1));
+	while (!stack.empty())
+	{
+		int curr = stack.back().first;
+		int from = stack.back().second;
+		stack.pop_back();
+
+		//every vertex above this entry has finished, so this one has too
+		if (curr < 0)
+		{
+			ws.SetCost(-curr - 1, clock++);
+			visitor.Finish(-curr - 1, ws);
+			continue;
+		}
+
+		//a vertex can be pushed by several edges; only the first pop discovers it
+		if (ws.Mark(curr))
+			continue;
+		ws.SetMark(curr, 1);
+		ws.SetPrev(curr, from);
+		ws.SetDist(curr, clock++);
+		order.push_back(curr);
+		stack.push_back(std::make_pair(-curr - 1, from));
+		visitor.Discover(curr, ws);
+
+		edges.clear();
+		graph.ForEachEdge(curr, [&](int next, double)
+		{
+			if (!ws.Mark(next))
+				edges.push_back(next);
+		});
+		for (int i = (int)edges.size() - 1; i >= 0; i--)
+			stack.push_back(std::make_pair(edges[i], curr));
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			PrimSearch
+*	Purpose:				Prim's algorithm from a source vertex. The heap holds each
+*							vertex outside the tree keyed by its cheapest edge from the
+*							tree, lowered by decrease-key when a cheaper edge is found
+*	Input Parameters:		const Adj &graph	the graph to search
+*							int source			index of the starting vertex
+*							Workspace &ws		receives the tree parents, edge costs, and
+*												distances through the tree
+*							Visitor &visitor	told of each tree vertex, each cheaper edge,
+*												and each tree vertex whose edges are done
+*	Return value:			double	the total weight of the minimum spanning tree
+********************************************************************************************/
+template <class Adj, class Visitor>
+double PrimSearch(const Adj &graph, int source, Workspace &ws, Visitor &visitor)
+{
+	ws.Begin(graph.VertexCount());
+	MinHeap<double> &heap = ws.Heap();
+	double total = 0;
+
+	ws.SetCost(source, 0);
+	ws.SetDist(source, 0);
+	heap.Push(source, 0);
+	while (!heap.Empty())
+	{
+		//add the vertex with the cheapest connecting edge to the tree
+		int curr = heap.Pop();
+		ws.SetMark(curr, 1);
+		total += ws.Cost(curr);
+		visitor.Settle(curr, ws);
+
+		graph.ForEachEdge(curr, [&](int next, double weight)
+		{
+			if (!ws.Mark(next) && weight < ws.Cost(next))
+			{
+				ws.SetCost(next, weight);
+				ws.SetDist(next, ws.Dist(curr) + weight);
+				ws.SetPrev(next, curr);
+				heap.Push(next, weight);
+				visitor.Relax(curr, next, weight, ws);
+			}
+		});
+		visitor.Finish(curr, ws);
+	}
+	return total;
+}
+
+/*******************************************************************************************
+*	Function Name:			FordSearch
+*	Purpose:				Ford's label-correcting shortest path algorithm from a source
+*							vertex. A vertex whose distance improves is queued unless it is
+*							already waiting in the queue, which ws.Mark records. The sum of
+*							the queued distances is kept so the average is known when a
+*							vertex is taken off the front. Each improvement sets the number
+*							of edges on the vertex's path; every V more edges the previous
+*							vertices are checked for the cycle a path that long implies.
+*	Input Parameters:		const Adj &graph		the graph to search
+*							int source				index of the starting vertex
+*							Workspace &ws			receives the distances, previous vertices,
+*													and path lengths
+*							vector<int> &cycle		receives a negative cycle, if one is found
+*							Visitor &visitor		told of each queued and dequeued vertex and
+*													each edge that shortens a distance
+*	Return value:			bool	false if a negative cycle was found
+********************************************************************************************/
+template <class Adj, class Visitor>
+bool FordSearch(const Adj &graph, int source, Workspace &ws, std::vector<int> &cycle, Visitor &visitor)
+{
+	std::deque<int> q;
+	double queued = 0;		//sum of the distances of the queued vertices
+	int n = graph.VertexCount();
+	bool found = false;
+
+	ws.Begin(n);
+	cycle.clear();
+	ws.SetDist(source, 0);
+	ws.SetCost(source, 0);
+	ws.SetMark(source, 1);
+	q.push_back(source);
+	visitor.Discover(source, ws);
+	while (!q.empty() && !found)
+	{
+		//pass over vertices above the average distance, at most once round the queue
+		double average = queued / q.size();
+		for (unsigned k = q.size(); k > 1 && ws.Dist(q.front()) > average; k--)
+		{
+			q.push_back(q.front());
+			q.pop_front();
+		}
+
+		int curr = q.front();
+		q.pop_front();
+		ws.SetMark(curr, 0);
+		queued -= ws.Dist(curr);
+		visitor.Examine(curr, ws);
+
+		double currDist = ws.Dist(curr);
+		double currEdges = ws.Cost(curr);
+		graph.ForEachEdgeUntil(curr, [&](int next, double cost)
+		{
+			if (!(currDist + cost < ws.Dist(next)))
+				return false;
+
+			if (ws.Mark(next))
+				queued -= ws.Dist(next);
+			ws.SetDist(next, currDist + cost);
+			ws.SetPrev(next, curr);
+			ws.SetCost(next, currEdges + 1);
+			visitor.Relax(curr, next, cost, ws);
+
+			//a path of V edges repeats a vertex, so look for the negative cycle it went round
+			if ((long long)ws.Cost(next) % n == 0 && PreviousCycle(ws, next, cycle))
+			{
+				found = true;
+				return true;
+			}
+
+			if (ws.Mark(next))
+				queued += ws.Dist(next);
+			else
+			{
+				ws.SetMark(next, 1);
+				queued += ws.Dist(next);
+				if (!q.empty() && ws.Dist(next) < ws.Dist(q.front()))
+					q.push_front(next);
+				else
+					q.push_back(next);
+				visitor.Discover(next, ws);
+			}
+			return false;
+		});
+	}
+	return !found;
+}
+
+/*******************************************************************************************
+*	Function Name:			PreviousCycle
+*	Purpose:				follows the previous vertices from a start vertex with a slow
+*							and a fast pointer, which meet only if the walk ends in a cycle,
+*							then walks the cycle once from the meeting point to list it
+*	Input Parameters:		const Workspace &ws		the workspace of a search
+*							int start				the vertex to start from
+*							vector<int> &cycle		receives the cycle in edge order
+*	Return value:			bool	true if a cycle was found
+********************************************************************************************/
+inline bool PreviousCycle(const Workspace &ws, int start, std::vector<int> &cycle)
+{
+	int slow = start;
+	int fast = start;
+
+	cycle.clear();
+	do
+	{
+		slow = ws.Prev(slow);
+		fast = ws.Prev(fast);
+		if (fast != -1)
+			fast = ws.Prev(fast);
+		if (fast == -1)
+			return false;
+	} while (slow != fast);
+
+	//previous vertices run against the edges, so list them backwards
+	int at = slow;
+	do
+	{
+		cycle.push_back(at);
+		at = ws.Prev(at);
+	} while (at != slow);
+	std::reverse(cycle.begin(), cycle.end());
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Names:			DijkstraSearch, BreadthFirstSearch, DepthFirstSearch, PrimSearch,
+*							FordSearch
+*	Purpose:				run the engines above with a NullVisitor, for callers that only
+*							want the results
+*	Input Parameters:		as above, without the visitor
+*	Return value:			as above
+********************************************************************************************/
+template <class Adj>
+double DijkstraSearch(const Adj &graph, int source, int target, Workspace &ws)
+{
+	NullVisitor visitor;
+	return DijkstraSearch(graph, source, target, ws, visitor);
+}
+
+template <class Adj>
+void BreadthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws)
+{
+	NullVisitor visitor;
+	BreadthFirstSearch(graph, source, order, ws, visitor);
+}
+
+template <class Adj>
+void DepthFirstSearch(const Adj &graph, int source, std::vector<int> &order, Workspace &ws)
+{
+	NullVisitor visitor;
+	DepthFirstSearch(graph, source, order, ws, visitor);
+}
+
+template <class Adj>
+double PrimSearch(const Adj &graph, int source, Workspace &ws)
+{
+	NullVisitor visitor;
+	return PrimSearch(graph, source, ws, visitor);
+}
+
+template <class Adj>
+bool FordSearch(const Adj &graph, int source, Workspace &ws, std::vector<int> &cycle)
+{
+	NullVisitor visitor;
+	return FordSearch(graph, source, ws, cycle, visitor);
+}
+
+#endif // !SEARCH_T
@@ -0,0 +1,186 @@
+/**************************************************************************************************
+*
+*   File name :			snapshotbuilder.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the SnapshotBuilder class, implemented in snapshotbuilder.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		SnapshotBuilder
+*
+*	Turns a graph file in the GetGraph format into a binary snapshot (mappedgraph.h) without
+*	holding the graph in memory, so a graph larger than memory can be built on one machine and
+*	then queried in place with a MappedGraph. The file is streamed once; the vertex names and
+*	coordinates go straight to temporary files, and the edge target names are resolved to
+*	indices by sorting the edges and the vertex names with ExternalSorter (externalsort.h) and
+*	merging the two sorted streams. The resolved edges are sorted back into file order to give
+*	the rows of the snapshot, and the sections are copied into the snapshot one after another.
+*	Only the sorters hold records in memory, within the memory allowed.
+*
+*	Structs:
+*		SnapshotName		a vertex name and its index, sorted by name
+*		SnapshotEdge		an edge with the name of its target, sorted by that name
+*		SnapshotArc			an edge with its target resolved, sorted back into file order
+*		SnapshotSlot		a vertex index and the home slot of its name in the hash table
+*		SnapshotBuildStats	the counts and time of the last build
+*
+*	Private data members:
+*		size_t memory		the memory the sorters may take in all
+*		string tempPrefix	the start of the temporary file names, "" to use the output name
+*		string prefix		the prefix of the build under way
+*		temporaries			the temporary files written, removed after the build
+*		vertexCount, edgeCount, nameBytes, slotCount	the counts of the snapshot
+*		stats				the counts and time of the last build
+*
+*	Private member functions:
+*		Scan				streams the graph file, writing the vertex sections and sorting
+*							the vertex names and edges
+*		Join				resolves the target of each edge by merging the sorted names and
+*							edges
+*		WriteRows			writes the offsets, targets, and weights from the resolved edges
+*		WriteSlots			writes the name hash table from the sorted home slots
+*		Assemble			copies the sections into the snapshot behind its header
+*		Append				copies a temporary file into the snapshot, folding it into the
+*							checksum
+*		Temporary			the name of a temporary file, remembered for removal
+*		RemoveTemporaries	removes the temporary files
+*
+*	Public member functions:
+*		SnapshotBuilder		constructor, with the memory allowed and the temporary file prefix
+*		~SnapshotBuilder	destructor, removes any temporary files left
+*		Build				builds a snapshot from a graph file
+*		Stats				the counts and time of the last build
+*
+****************************************************************************************************/
+
+#ifndef SNAPSHOTBUILDER_H
+#define SNAPSHOTBUILDER_H
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include "mappedfile.h"
+#include "mappedgraph.h"
+#include "externalsort.h"
+
+const std::size_t DEFAULT_BUILD_MEMORY_BYTES = 256 << 20;	// Memory the sorters of a build may take
+
+struct SnapshotName
+{
+	std::string name;	// Vertex name
+	int index;			// Vertex index, the position of the vertex in the file
+
+	bool operator<(const SnapshotName &other) const
+	{
+		int order = name.compare(other.name);
+		return order < 0 || (order == 0 && index < other.index);
+	}
+	void Write(std::ostream &out) const;
+	bool Read(std::istream &in);
+	std::size_t Bytes() const { return sizeof(*this) + name.capacity(); }
+};
+
+template <class Weight>
+struct SnapshotEdge
+{
+	std::string target;		// Name of the vertex the edge leads to
+	long long order;		// Position of the edge in the file
+	int source;				// Index of the vertex the edge leaves
+	Weight weight;			// Edge weight
+
+	bool operator<(const SnapshotEdge &other) const
+	{
+		int compare = target.compare(other.target);
+		return compare < 0 || (compare == 0 && order < other.order);
+	}
+	void Write(std::ostream &out) const;
+	bool Read(std::istream &in);
+	std::size_t Bytes() const { return sizeof(*this) + target.capacity(); }
+};
+
+template <class Weight>
+struct SnapshotArc
+{
+	long long order;		// Position of the edge in the file
+	int source;				// Index of the vertex the edge leaves
+	int target;				// Index of the vertex the edge leads to
+	Weight weight;			// Edge weight
+
+	bool operator<(const SnapshotArc &other) const { return order < other.order; }
+	void Write(std::ostream &out) const { out.write((const char *)this, sizeof(*this)); }
+	bool Read(std::istream &in) { return (bool)in.read((char *)this, sizeof(*this)); }
+	std::size_t Bytes() const { return sizeof(*this); }
+};
+
+struct SnapshotSlot
+{
+	unsigned long long home;	// Slot the hash of the name falls in
+	int index;					// Vertex index
+
+	bool operator<(const SnapshotSlot &other) const { return home < other.home || (home == other.home && index < other.index); }
+	void Write(std::ostream &out) const { out.write((const char *)this, sizeof(*this)); }
+	bool Read(std::istream &in) { return (bool)in.read((char *)this, sizeof(*this)); }
+	std::size_t Bytes() const { return sizeof(*this); }
+};
+
+struct SnapshotBuildStats
+{
+	int vertices = 0;				// Vertices in the snapshot
+	long long edges = 0;			// Edges in the snapshot
+	long long danglingEdges = 0;	// Edges left out because no vertex has their target's name
+	int runs = 0;					// Sorted runs written to temporary files
+	double seconds = 0;				// Time the build took
+};
+
+template <class V, class W>
+class SnapshotBuilder
+{
+public:
+	typedef typename W::weightType weightType;	// Type of the edge weights
+
+	// Lets the sorters of a build hold at most about memoryBytes of records. The
+	// temporary files are named after tempPrefix, or after the output file if it is
+	// empty, so they go on the same disk.
+	explicit SnapshotBuilder(std::size_t memoryBytes = DEFAULT_BUILD_MEMORY_BYTES, const std::string &tempPrefix = "");
+
+	~SnapshotBuilder();	// Destructor, removes any temporary files left
+
+	// Reads the graph file at input, in the GetGraph format, and writes its snapshot to
+	// output, with the vertices in file order as LoadGraph would number them. Edges to
+	// names of no vertex are left out, as SaveBinary does. Returns false, writing no
+	// snapshot, if input cannot be read, ends in the middle of a vertex, or names a
+	// vertex #, or if a file cannot be written. O(E log E) time, in passes over temporary files of O(E) size.
+	bool Build(const std::string &input, const std::string &output);
+
+	// Counts and time of the last build
+	const SnapshotBuildStats &Stats() const;
+
+private:
+	SnapshotBuilder(const SnapshotBuilder &);
+	SnapshotBuilder &operator=(const SnapshotBuilder &);
+	bool Scan(const std::string &input, ExternalSorter<SnapshotName> &names, ExternalSorter<SnapshotEdge<weightType> > &edges);
+	bool Join(ExternalSorter<SnapshotName> &names, ExternalSorter<SnapshotEdge<weightType> > &edges,
+		ExternalSorter<SnapshotArc<weightType> > &arcs, ExternalSorter<SnapshotSlot> &slots);
+	bool WriteRows(ExternalSorter<SnapshotArc<weightType> > &arcs);
+	bool WriteSlots(ExternalSorter<SnapshotSlot> &slots);
+	bool Assemble(const std::string &output);
+	bool Append(std::ostream &out, const std::string &name, unsigned long long length, unsigned long long &sum);
+	std::string Temporary(const char *suffix);
+	void RemoveTemporaries();
+	std::size_t memory;
+	std::string tempPrefix;
+	std::string prefix;
+	std::vector<std::string> temporaries;
+	unsigned long long vertexCount;
+	unsigned long long edgeCount;
+	unsigned long long nameBytes;
+	unsigned long long slotCount;
+	SnapshotBuildStats stats;
+};
+#include "snapshotbuilder.t"
+#endif // !SNAPSHOTBUILDER_H
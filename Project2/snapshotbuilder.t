@@ -0,0 +1,531 @@
+/**************************************************************************************************
+*
+*   File name :			snapshotbuilder.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the out of core snapshot builder and its records
+*	defined in snapshotbuilder.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef SNAPSHOTBUILDER_T
+#define SNAPSHOTBUILDER_T
+
+/*******************************************************************************************
+*	Function Name:			Write
+*	Purpose:				writes a name record to a run, its length first
+*	Input Parameters:		std::ostream &out	the run
+*	Return value:			void
+********************************************************************************************/
+inline void SnapshotName::Write(std::ostream &out) const
+{
+	unsigned length = name.size();
+	out.write((const char *)&length, sizeof(length));
+	out.write(name.data(), length);
+	out.write((const char *)&index, sizeof(index));
+}
+
+/*******************************************************************************************
+*	Function Name:			Read
+*	Purpose:				reads a name record from a run
+*	Input Parameters:		std::istream &in	the run
+*	Return value:			bool	false at the end of the run
+********************************************************************************************/
+inline bool SnapshotName::Read(std::istream &in)
+{
+	unsigned length;
+	if (!in.read((char *)&length, sizeof(length)))
+		return false;
+	name.resize(length);
+	if (length > 0 && !in.read(&name[0], length))
+		return false;
+	return (bool)in.read((char *)&index, sizeof(index));
+}
+
+/*******************************************************************************************
+*	Function Name:			Write
+*	Purpose:				writes an edge record to a run, the length of its target first
+*	Input Parameters:		std::ostream &out	the run
+*	Return value:			void
+********************************************************************************************/
+template <class Weight>
+void SnapshotEdge<Weight>::Write(std::ostream &out) const
+{
+	unsigned length = target.size();
+	out.write((const char *)&length, sizeof(length));
+	out.write(target.data(), length);
+	out.write((const char *)&order, sizeof(order));
+	out.write((const char *)&source, sizeof(source));
+	out.write((const char *)&weight, sizeof(weight));
+}
+
+/*******************************************************************************************
+*	Function Name:			Read
+*	Purpose:				reads an edge record from a run
+*	Input Parameters:		std::istream &in	the run
+*	Return value:			bool	false at the end of the run
+********************************************************************************************/
+template <class Weight>
+bool SnapshotEdge<Weight>::Read(std::istream &in)
+{
+	unsigned length;
+	if (!in.read((char *)&length, sizeof(length)))
+		return false;
+	target.resize(length);
+	if (length > 0 && !in.read(&target[0], length))
+		return false;
+	in.read((char *)&order, sizeof(order));
+	in.read((char *)&source, sizeof(source));
+	return (bool)in.read((char *)&weight, sizeof(weight));
+}
+
+/*******************************************************************************************
+*	Function Name:			SnapshotBuilder()			the constructor
+*	Purpose:				creates a builder
+*	Input Parameters:		std::size_t memoryBytes			the memory the sorters may take
+*							const std::string &tempPrefix	the start of the temporary file
+*															names, "" to use the output name
+*	Return value:			none
+********************************************************************************************/
+template <class V, class W>
+SnapshotBuilder<V, W>::SnapshotBuilder(std::size_t memoryBytes, const std::string &tempPrefix)
+{
+	memory = memoryBytes;
+	this->tempPrefix = tempPrefix;
+	vertexCount = 0;
+	edgeCount = 0;
+	nameBytes = 0;
+	slotCount = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			~SnapshotBuilder()			the destructor
+*	Purpose:				removes any temporary files left
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+template <class V, class W>
+SnapshotBuilder<V, W>::~SnapshotBuilder()
+{
+	RemoveTemporaries();
+}
+
+/*******************************************************************************************
+*	Function Name:			Build
+*	Purpose:				builds a snapshot from a graph file in four passes: the scan of
+*							the file, the join of the sorted names and edges, the rows and
+*							hash table written from their sorted records, and the assembly
+*							of the sections. The scan and the join each give half of the
+*							memory to the two sorters they fill, most of it to the edges;
+*							a sorter being merged holds at most what it held when it filled.
+*	Input Parameters:		const std::string &input	the graph file
+*							const std::string &output	the snapshot to write
+*	Return value:			bool	false if the snapshot could not be built
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::Build(const std::string &input, const std::string &output)
+{
+	static_assert(std::is_same<typename V::nameType, std::string>::value, "snapshots store vertex names as strings");
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	stats = SnapshotBuildStats();
+	prefix = tempPrefix.empty() ? output + ".part" : tempPrefix;
+	bool built;
+	{
+		ExternalSorter<SnapshotName> names(memory / 8, prefix + ".names.run");
+		ExternalSorter<SnapshotEdge<weightType> > edges(memory / 8 * 3, prefix + ".edges.run");
+		ExternalSorter<SnapshotArc<weightType> > arcs(memory / 8 * 3, prefix + ".arcs.run");
+		ExternalSorter<SnapshotSlot> slots(memory / 8, prefix + ".slots.run");
+
+		built = Scan(input, names, edges) && Join(names, edges, arcs, slots)
+			&& WriteRows(arcs) && WriteSlots(slots) && Assemble(output);
+		stats.runs = names.Runs() + edges.Runs() + arcs.Runs() + slots.Runs();
+	}
+	RemoveTemporaries();
+
+	stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return built;
+}
+
+/*******************************************************************************************
+*	Function Name:			Stats
+*	Purpose:				the counts and time of the last build
+*	Input Parameters:		none
+*	Return value:			const SnapshotBuildStats &
+********************************************************************************************/
+template <class V, class W>
+const SnapshotBuildStats &SnapshotBuilder<V, W>::Stats() const
+{
+	return stats;
+}
+
+/*******************************************************************************************
+*	Function Name:			Scan
+*	Purpose:				streams the graph file through a mapping. The name bytes, name
+*							offsets, and coordinates of each vertex are written to their
+*							temporary files in file order; each name goes to one sorter with
+*							its index and each edge to the other with its target name.
+*	Input Parameters:		const std::string &input			the graph file
+*							ExternalSorter<SnapshotName> &names	receives the vertex names
+*							edges								receives the edges
+*	Return value:			bool	false if the file cannot be read or ends in the middle of
+*									a vertex, or a temporary file cannot be written
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::Scan(const std::string &input, ExternalSorter<SnapshotName> &names,
+	ExternalSorter<SnapshotEdge<weightType> > &edges)
+{
+	MappedFile file;
+	if (!file.Open(input))
+		return false;
+
+	std::ofstream nameOut(Temporary(".names").c_str(), std::ios::binary | std::ios::trunc);
+	std::ofstream startOut(Temporary(".starts").c_str(), std::ios::binary | std::ios::trunc);
+	std::ofstream locatedOut(Temporary(".located").c_str(), std::ios::binary | std::ios::trunc);
+	std::ofstream coordinateOut(Temporary(".coordinates").c_str(), std::ios::binary | std::ios::trunc);
+
+	TokenScanner scanner(file.Data(), file.Data() + file.Size());
+	const char *token;		//the current token, from token up to tokenEnd
+	const char *tokenEnd;
+	SnapshotName name;
+	SnapshotEdge<weightType> edge;
+	long long order = 0;
+	int n = 0;
+
+	nameBytes = 0;
+	startOut.write((const char *)&nameBytes, sizeof(nameBytes));
+	while (scanner.Next(token, tokenEnd))
+	{
+		//no vertex may be named #, as in LoadGraph
+		if (n == 0x7fffffff || (tokenEnd - token == 1 && *token == '#'))
+			return false;
+
+		//the name goes to its section now and to the sorter for the join
+		name.name.assign(token, tokenEnd);
+		name.index = n;
+		names.Add(name);
+		nameOut.write(token, tokenEnd - token);
+		nameBytes += tokenEnd - token;
+		startOut.write((const char *)&nameBytes, sizeof(nameBytes));
+
+		//read the edges, after the coordinates if there are any
+		double xy[2] = { 0, 0 };
+		char located = 0;
+		bool complete = scanner.Next(token, tokenEnd);
+		if (complete && tokenEnd - token == 1 && *token == '@')
+		{
+			complete = scanner.Next(token, tokenEnd) && TokenScanner::ParseNumber(token, tokenEnd, xy[0])
+				&& scanner.Next(token, tokenEnd) && TokenScanner::ParseNumber(token, tokenEnd, xy[1])
+				&& scanner.Next(token, tokenEnd);
+			located = 1;
+		}
+		while (complete && !(tokenEnd - token == 1 && *token == '#'))
+		{
+			edge.target.assign(token, tokenEnd);
+			edge.order = order++;
+			edge.source = n;
+			complete = scanner.Next(token, tokenEnd) && TokenScanner::ParseNumber(token, tokenEnd, edge.weight)
+				&& scanner.Next(token, tokenEnd);
+			if (complete)
+				edges.Add(edge);
+		}
+		if (!complete)
+			return false;
+
+		locatedOut.put(located);
+		coordinateOut.write((const char *)xy, sizeof(xy));
+		n++;
+	}
+
+	vertexCount = n;
+	stats.vertices = n;
+	nameOut.close();
+	startOut.close();
+	locatedOut.close();
+	coordinateOut.close();
+	return !nameOut.fail() && !startOut.fail() && !locatedOut.fail() && !coordinateOut.fail()
+		&& !names.Failed() && !edges.Failed();
+}
+
+/*******************************************************************************************
+*	Function Name:			Join
+*	Purpose:				walks the names and the edges, both sorted by name, side by side.
+*							The names of each run of equal names before an edge's target are
+*							passed, the first of each run, the lowest index, going to the
+*							hash table with its home slot; an edge whose target is the next
+*							name gets that name's index and goes back into file order.
+*	Input Parameters:		ExternalSorter<SnapshotName> &names		the vertex names
+*							edges									the edges by target name
+*							arcs									receives the resolved edges
+*							ExternalSorter<SnapshotSlot> &slots		receives the hash table
+*																	entries
+*	Return value:			bool	false if a sorter could not write or read its runs
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::Join(ExternalSorter<SnapshotName> &names, ExternalSorter<SnapshotEdge<weightType> > &edges,
+	ExternalSorter<SnapshotArc<weightType> > &arcs, ExternalSorter<SnapshotSlot> &slots)
+{
+	if (!names.Finish() || !edges.Finish())
+		return false;
+
+	//the same table size as MappedGraph::Write, at least twice the vertices
+	slotCount = 1;
+	while (slotCount < 2 * vertexCount + 1)
+		slotCount *= 2;
+
+	SnapshotName name;
+	SnapshotEdge<weightType> edge;
+	SnapshotArc<weightType> arc;
+	SnapshotSlot slot;
+	std::string previous;
+	bool haveName = names.Next(name);
+	bool first = true;
+
+	while (true)
+	{
+		bool haveEdge = edges.Next(edge);
+
+		//pass the names before the target, or all that are left after the last edge
+		while (haveName && (!haveEdge || name.name < edge.target))
+		{
+			if (first || name.name != previous)
+			{
+				slot.home = MappedGraph<V, W>::Hash(name.name.data(), name.name.size()) & (slotCount - 1);
+				slot.index = name.index;
+				slots.Add(slot);
+				previous = name.name;
+				first = false;
+			}
+			haveName = names.Next(name);
+		}
+		if (!haveEdge)
+			break;
+
+		if (haveName && name.name == edge.target)
+		{
+			arc.order = edge.order;
+			arc.source = edge.source;
+			arc.target = name.index;
+			arc.weight = edge.weight;
+			arcs.Add(arc);
+		}
+		else
+			stats.danglingEdges++;
+	}
+
+	edgeCount = arcs.Count();
+	stats.edges = edgeCount;
+	return edgeCount < 0x7fffffffULL && !names.Failed() && !edges.Failed() && !arcs.Failed() && !slots.Failed();
+}
+
+/*******************************************************************************************
+*	Function Name:			WriteRows
+*	Purpose:				writes the offsets, targets, and weights sections from the
+*							resolved edges in file order, where the edges of each vertex
+*							are together and the vertices are in index order
+*	Input Parameters:		arcs	the resolved edges
+*	Return value:			bool	false if a file could not be written or read
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::WriteRows(ExternalSorter<SnapshotArc<weightType> > &arcs)
+{
+	if (!arcs.Finish())
+		return false;
+
+	std::ofstream offsetOut(Temporary(".offsets").c_str(), std::ios::binary | std::ios::trunc);
+	std::ofstream targetOut(Temporary(".targets").c_str(), std::ios::binary | std::ios::trunc);
+	std::ofstream weightOut(Temporary(".weights").c_str(), std::ios::binary | std::ios::trunc);
+	SnapshotArc<weightType> arc;
+	int written = 0;
+	unsigned long long row = 0;		//the vertex whose row is being written
+
+	offsetOut.write((const char *)&written, sizeof(written));
+	while (arcs.Next(arc))
+	{
+		//end the rows up to the source, some of them empty
+		for (; row < (unsigned long long)arc.source; row++)
+			offsetOut.write((const char *)&written, sizeof(written));
+		targetOut.write((const char *)&arc.target, sizeof(arc.target));
+		weightOut.write((const char *)&arc.weight, sizeof(arc.weight));
+		written++;
+	}
+	for (; row < vertexCount; row++)
+		offsetOut.write((const char *)&written, sizeof(written));
+
+	offsetOut.close();
+	targetOut.close();
+	weightOut.close();
+	return !offsetOut.fail() && !targetOut.fail() && !weightOut.fail() && !arcs.Failed();
+}
+
+/*******************************************************************************************
+*	Function Name:			WriteSlots
+*	Purpose:				writes the name hash table from the entries sorted by home slot.
+*							Each entry goes in its home slot or the first free slot after
+*							the one before it, so every slot between an entry's home and
+*							its place is full, as linear probing needs. Entries pushed past
+*							the end wrap around into the first free slots from the start.
+*	Input Parameters:		ExternalSorter<SnapshotSlot> &slots		the hash table entries
+*	Return value:			bool	false if a file could not be written or read
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::WriteSlots(ExternalSorter<SnapshotSlot> &slots)
+{
+	if (!slots.Finish())
+		return false;
+
+	std::string name = Temporary(".slots");
+	std::fstream out(name.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	SnapshotSlot slot;
+	std::vector<int> wrapped;
+	unsigned long long position = 0;	//the next slot to write
+	const int empty = -1;
+
+	while (slots.Next(slot))
+	{
+		for (; position < slot.home; position++)
+			out.write((const char *)&empty, sizeof(empty));
+		if (position == slotCount)
+			wrapped.push_back(slot.index);
+		else
+		{
+			out.write((const char *)&slot.index, sizeof(slot.index));
+			position++;
+		}
+	}
+	for (; position < slotCount; position++)
+		out.write((const char *)&empty, sizeof(empty));
+
+	//the table is at least half empty, so the wrapped entries find room near the start
+	int entry;
+	for (unsigned long long i = 0; !wrapped.empty() && out.seekg(i * sizeof(int)) && out.read((char *)&entry, sizeof(entry)); i++)
+	{
+		if (entry != -1)
+			continue;
+		out.seekp(i * sizeof(int));
+		out.write((const char *)&wrapped.back(), sizeof(int));
+		wrapped.pop_back();
+	}
+
+	out.close();
+	return wrapped.empty() && !out.fail() && !slots.Failed();
+}
+
+/*******************************************************************************************
+*	Function Name:			Assemble
+*	Purpose:				writes the snapshot: the header, then each section copied from
+*							its temporary file and padded, then the header again with the
+*							checksum folded in along the way. A snapshot that cannot be
+*							finished is removed.
+*	Input Parameters:		const std::string &output	the snapshot to write
+*	Return value:			bool	false if a file could not be written or read
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::Assemble(const std::string &output)
+{
+	SnapshotHeader head;
+	memset(&head, 0, sizeof(head));
+	memcpy(head.magic, "GRAPHSNP", 8);
+	head.version = SNAPSHOT_VERSION;
+	head.byteOrder = SNAPSHOT_BYTE_ORDER;
+	head.weightBytes = sizeof(weightType);
+	head.weightIntegral = std::is_integral<weightType>::value ? 1 : 0;
+	head.vertexCount = vertexCount;
+	head.edgeCount = edgeCount;
+	head.nameBytes = nameBytes;
+	head.slotCount = slotCount;
+
+	unsigned long long section[9];
+	MappedGraph<V, W>::Layout(head, section);
+	head.bodyBytes = section[8];
+
+	//the temporary files in section order, with the lengths they should have
+	std::string names[8] = { prefix + ".offsets", prefix + ".targets", prefix + ".weights", prefix + ".starts",
+		prefix + ".names", prefix + ".slots", prefix + ".located", prefix + ".coordinates" };
+	unsigned long long lengths[8] = { (vertexCount + 1) * sizeof(int), edgeCount * sizeof(int), edgeCount * sizeof(weightType),
+		(vertexCount + 1) * sizeof(unsigned long long), nameBytes, slotCount * sizeof(int), vertexCount, 2 * vertexCount * sizeof(double) };
+
+	std::ofstream out(output.c_str(), std::ios::binary | std::ios::trunc);
+	const char zeros[8] = { 0 };
+	unsigned long long sum = 14695981039346656037ULL;
+	bool copied = (bool)out.write((const char *)&head, sizeof(head));
+	for (int i = 0; i < 8 && copied; i++)
+	{
+		copied = Append(out, names[i], lengths[i], sum);
+		out.write(zeros, section[i + 1] - section[i] - lengths[i]);
+	}
+
+	head.checksum = sum;
+	out.seekp(0);
+	out.write((const char *)&head, sizeof(head));
+	out.close();
+
+	//a snapshot that was not finished must not be opened later
+	if (!copied || out.fail())
+	{
+		std::remove(output.c_str());
+		return false;
+	}
+	return true;
+}
+
+/*******************************************************************************************
+*	Function Name:			Append
+*	Purpose:				copies a temporary file onto the end of the snapshot in blocks
+*							of a multiple of eight bytes, so the checksum of the blocks is
+*							the checksum of the whole section
+*	Input Parameters:		std::ostream &out				the snapshot
+*							const std::string &name			the temporary file
+*							unsigned long long length		the length the file should have
+*							unsigned long long &sum			the checksum to fold it into
+*	Return value:			bool	false if the file is not that long or cannot be copied
+********************************************************************************************/
+template <class V, class W>
+bool SnapshotBuilder<V, W>::Append(std::ostream &out, const std::string &name, unsigned long long length, unsigned long long &sum)
+{
+	std::ifstream in(name.c_str(), std::ios::binary);
+	std::vector<char> block(1 << 20);
+	while (length > 0 && in)
+	{
+		std::size_t count = length < block.size() ? (std::size_t)length : block.size();
+		if (!in.read(block.data(), count))
+			return false;
+		sum = MappedGraph<V, W>::Checksum(sum, block.data(), count);
+		out.write(block.data(), count);
+		length -= count;
+	}
+	return length == 0 && (bool)out && in.peek() == std::char_traits<char>::eof();
+}
+
+/*******************************************************************************************
+*	Function Name:			Temporary
+*	Purpose:				the name of a temporary file of the build, remembered so it is
+*							removed afterwards
+*	Input Parameters:		const char *suffix	the end of the name
+*	Return value:			std::string
+********************************************************************************************/
+template <class V, class W>
+std::string SnapshotBuilder<V, W>::Temporary(const char *suffix)
+{
+	temporaries.push_back(prefix + suffix);
+	return temporaries.back();
+}
+
+/*******************************************************************************************
+*	Function Name:			RemoveTemporaries
+*	Purpose:				removes the temporary files of the build
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+template <class V, class W>
+void SnapshotBuilder<V, W>::RemoveTemporaries()
+{
+	for (unsigned i = 0; i < temporaries.size(); i++)
+		std::remove(temporaries[i].c_str());
+	temporaries.clear();
+}
+
+#endif // !SNAPSHOTBUILDER_T
@@ -0,0 +1,58 @@
+/**************************************************************************************************
+*
+*   File name :			spanning.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the spanning tree engines, implemented in spanning.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Like the engines in search.h, these work on vertex indices of any graph type Adj with a
+*	VertexCount() and a ForEachEdge(u, visit). Each edge in an edgelist is treated as an
+*	undirected edge, so a graph read with both directions of every edge gives the usual
+*	minimum spanning tree. The trees come back as a list of edges with the total weight.
+*
+*	Structs:
+*		TreeEdge			an edge of a spanning tree: two vertex indices and a weight
+*
+*	Functions:
+*		PrimTree			Prim's algorithm on the indexed min-heap (PrimSearch) for the
+*							minimum spanning tree of the source vertex's component
+*		KruskalForest		Kruskal's algorithm on the edges sorted by weight and a
+*							union-find, for the minimum spanning forest of the whole graph
+*
+****************************************************************************************************/
+
+#ifndef SPANNING_H
+#define SPANNING_H
+#include <vector>
+#include <algorithm>
+#include "search.h"
+#include "disjointsets.h"
+
+struct TreeEdge
+{
+	int from;		// the vertex already in the tree
+	int to;			// the vertex the edge adds to the tree
+	double weight;
+};
+
+// Minimum spanning tree of the component of source using Prim's algorithm. tree
+// receives one edge for each vertex other than source in the component. The
+// visitor is passed on to PrimSearch. Returns the total weight. O((V + E) log V)
+template <class Adj>
+double PrimTree(const Adj &graph, int source, std::vector<TreeEdge> &tree, Workspace &ws);
+template <class Adj, class Visitor>
+double PrimTree(const Adj &graph, int source, std::vector<TreeEdge> &tree, Workspace &ws, Visitor &visitor);
+
+// Minimum spanning forest of the whole graph using Kruskal's algorithm. tree receives
+// the edges in order of weight, V - 1 of them for a connected graph. Returns the total
+// weight. O(E log E)
+template <class Adj>
+double KruskalForest(const Adj &graph, std::vector<TreeEdge> &tree);
+
+#include "spanning.t"
+#endif // !SPANNING_H
@@ -0,0 +1,109 @@
+/**************************************************************************************************
+*
+*   File name :			spanning.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the spanning tree engines defined in spanning.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef SPANNING_T
+#define SPANNING_T
+
+/*******************************************************************************************
+*	Function Name:			PrimTree
+*	Purpose:				runs PrimSearch from a source vertex and lists the edge each
+*							vertex joined the tree by, in the order the vertices were
+*							first reached
+*	Input Parameters:		const Adj &graph			the graph
+*							int source					index of the starting vertex
+*							vector<TreeEdge> &tree		filled with the tree edges
+*							Workspace &ws				scratch space for the search
+*							Visitor &visitor			passed on to PrimSearch
+*	Return value:			double	the total weight of the tree
+********************************************************************************************/
+template <class Adj, class Visitor>
+double PrimTree(const Adj &graph, int source, std::vector<TreeEdge> &tree, Workspace &ws, Visitor &visitor)
+{
+	double total = PrimSearch(graph, source, ws, visitor);
+
+	//every vertex the search touched joined the tree, by the edge from its parent
+	tree.clear();
+	const std::vector<int> &touched = ws.Touched();
+	for (unsigned i = 0; i < touched.size(); i++)
+	{
+		int v = touched[i];
+		if (ws.Prev(v) != -1)
+		{
+			TreeEdge edge = { ws.Prev(v), v, ws.Cost(v) };
+			tree.push_back(edge);
+		}
+	}
+	return total;
+}
+
+/*******************************************************************************************
+*	Function Name:			PrimTree
+*	Purpose:				runs PrimTree above with a NullVisitor
+*	Input Parameters:		as above, without the visitor
+*	Return value:			as above
+********************************************************************************************/
+template <class Adj>
+double PrimTree(const Adj &graph, int source, std::vector<TreeEdge> &tree, Workspace &ws)
+{
+	NullVisitor visitor;
+	return PrimTree(graph, source, tree, ws, visitor);
+}
+
+/*******************************************************************************************
+*	Function Name:			KruskalForest
+*	Purpose:				Kruskal's algorithm. Every edge is gathered and sorted by weight,
+*							then taken in that order whenever it joins two different trees
+*							of the forest so far. Equal weights are broken by vertex index
+*							so the forest does not depend on the sort.
+*	Input Parameters:		const Adj &graph			the graph
+*							vector<TreeEdge> &tree		filled with the forest edges
+*	Return value:			double	the total weight of the forest
+********************************************************************************************/
+template <class Adj>
+double KruskalForest(const Adj &graph, std::vector<TreeEdge> &tree)
+{
+	std::vector<TreeEdge> edges;	//every edge of the graph
+	DisjointSets forest;			//the trees built so far
+	int n = graph.VertexCount();
+	double total = 0;
+
+	for (int u = 0; u < n; u++)
+	{
+		graph.ForEachEdge(u, [&](int v, double weight)
+		{
+			TreeEdge edge = { u, v, weight };
+			edges.push_back(edge);
+		});
+	}
+	std::sort(edges.begin(), edges.end(), [](const TreeEdge &a, const TreeEdge &b)
+	{
+		if (a.weight != b.weight)
+			return a.weight < b.weight;
+		if (a.from != b.from)
+			return a.from < b.from;
+		return a.to < b.to;
+	});
+
+	tree.clear();
+	forest.Reset(n);
+	for (unsigned i = 0; i < edges.size() && forest.Sets() > 1; i++)
+	{
+		if (forest.Union(edges[i].from, edges[i].to))
+		{
+			tree.push_back(edges[i]);
+			total += edges[i].weight;
+		}
+	}
+	return total;
+}
+
+#endif // !SPANNING_T
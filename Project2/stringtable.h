@@ -0,0 +1,97 @@
+/**************************************************************************************************
+*
+*   File name :			stringtable.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the StringTable class, implemented in stringtable.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		StringTable
+*
+*	Interns strings: each distinct string is stored once and given a symbol, a small integer
+*	counting up from 0 in the order the strings were first seen. The bytes of the strings are
+*	packed one after another into large blocks, so a string takes no allocation of its own,
+*	and a hash table of symbols finds a string's symbol by probing from the slot of its hash.
+*	Strings are never removed; the table is emptied as a whole.
+*
+*	Structs:
+*		Entry				where the bytes of a symbol's string are, its length, and its hash
+*
+*	Private data members:
+*		blocks				the blocks the bytes of the strings are packed into
+*		entries				the Entry of each symbol, by symbol
+*		vector<int> slots	the hash table, the symbol in each slot or -1 if it is empty
+*
+*	Private member functions:
+*		Hash				the FNV-1a hash of a string
+*		Probe				the slot holding a string, or the empty slot it would go in
+*		Grow				doubles the hash table
+*
+*	Public member functions:
+*		StringTable			constructor for an empty table
+*		Intern				the symbol of a string, adding the string if it is new
+*		Find				the symbol of a string, -1 if it has not been added
+*		Name				a copy of the string of a symbol
+*		Data				the bytes of the string of a symbol
+*		Length				the length of the string of a symbol
+*		Size				the number of symbols
+*		Bytes				the memory the table takes
+*		Clear				removes every string
+*
+****************************************************************************************************/
+
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+#include <string>
+#include <vector>
+#include <cstring>
+
+const std::size_t STRING_BLOCK_BYTES = 64 << 10;	// Size of the blocks strings are packed into
+
+class StringTable
+{
+public:
+	StringTable();	// Constructor
+
+	// Symbol of the length bytes at text, storing them under a new symbol if they have
+	// not been interned before. O(length) on average
+	int Intern(const char *text, std::size_t length);
+	int Intern(const std::string &text);
+
+	// Symbol of the length bytes at text, -1 if they have not been interned
+	int Find(const char *text, std::size_t length) const;
+	int Find(const std::string &text) const;
+
+	// Copy of the string of a symbol
+	std::string Name(int symbol) const;
+
+	// First byte of the string of a symbol, not null terminated. Valid until the next
+	// Intern or Clear.
+	const char *Data(int symbol) const;
+
+	std::size_t Length(int symbol) const;	// Length of the string of a symbol
+	int Size() const;						// Number of symbols; they run from 0 to Size() - 1
+	std::size_t Bytes() const;				// Memory the blocks, entries, and hash table take
+	void Clear();							// Removes every string, giving the memory back
+
+private:
+	struct Entry
+	{
+		unsigned block;		// Block holding the string
+		unsigned offset;	// Position of the string in its block
+		unsigned length;	// Length of the string
+		unsigned hash;		// Hash of the string, so probes and Grow need not rehash it
+	};
+	static unsigned Hash(const char *text, std::size_t length);
+	std::size_t Probe(const char *text, std::size_t length, unsigned hash) const;
+	void Grow();
+	std::vector<std::vector<char> > blocks;
+	std::vector<Entry> entries;
+	std::vector<int> slots;
+};
+#include "stringtable.t"
+#endif // !STRINGTABLE_H
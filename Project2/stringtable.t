@@ -0,0 +1,237 @@
+/**************************************************************************************************
+*
+*   File name :			stringtable.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the StringTable class defined in stringtable.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef STRINGTABLE_T
+#define STRINGTABLE_T
+
+/*******************************************************************************************
+*	Function Name:			StringTable()			the constructor
+*	Purpose:				creates an empty table
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline StringTable::StringTable()
+{
+
+}
+
+/*******************************************************************************************
+*	Function Name:			Intern
+*	Purpose:				finds the symbol of a string, or packs the string into the last
+*							block and gives it the next symbol. A string that does not fit
+*							in the space left starts a new block, one of its own if it is
+*							longer than a block.
+*	Input Parameters:		const char *text		the first byte of the string
+*							size_t length			the length of the string
+*	Return value:			int		the symbol of the string
+********************************************************************************************/
+inline int StringTable::Intern(const char *text, std::size_t length)
+{
+	//keep the table at most half full so probes stay short
+	if (2 * (entries.size() + 1) > slots.size())
+		Grow();
+
+	unsigned hash = Hash(text, length);
+	std::size_t slot = Probe(text, length, hash);
+	if (slots[slot] != -1)
+		return slots[slot];
+
+	if (blocks.empty() || blocks.back().size() + length > STRING_BLOCK_BYTES)
+	{
+		blocks.push_back(std::vector<char>());
+		blocks.back().reserve(length > STRING_BLOCK_BYTES ? length : STRING_BLOCK_BYTES);
+	}
+
+	Entry entry;
+	entry.block = blocks.size() - 1;
+	entry.offset = blocks.back().size();
+	entry.length = length;
+	entry.hash = hash;
+	blocks.back().insert(blocks.back().end(), text, text + length);
+	entries.push_back(entry);
+	slots[slot] = entries.size() - 1;
+	return slots[slot];
+}
+
+/*******************************************************************************************
+*	Function Name:			Intern
+*	Purpose:				finds the symbol of a string, adding the string if it is new
+*	Input Parameters:		const string &text	the string
+*	Return value:			int		the symbol of the string
+********************************************************************************************/
+inline int StringTable::Intern(const std::string &text)
+{
+	return Intern(text.data(), text.size());
+}
+
+/*******************************************************************************************
+*	Function Name:			Find
+*	Purpose:				finds the symbol of a string without adding it
+*	Input Parameters:		const char *text		the first byte of the string
+*							size_t length			the length of the string
+*	Return value:			int		the symbol of the string, -1 if it has not been interned
+********************************************************************************************/
+inline int StringTable::Find(const char *text, std::size_t length) const
+{
+	if (slots.empty())
+		return -1;
+	return slots[Probe(text, length, Hash(text, length))];
+}
+
+/*******************************************************************************************
+*	Function Name:			Find
+*	Purpose:				finds the symbol of a string without adding it
+*	Input Parameters:		const string &text	the string
+*	Return value:			int		the symbol of the string, -1 if it has not been interned
+********************************************************************************************/
+inline int StringTable::Find(const std::string &text) const
+{
+	return Find(text.data(), text.size());
+}
+
+/*******************************************************************************************
+*	Function Name:			Name
+*	Purpose:				copies the string of a symbol out of its block
+*	Input Parameters:		int symbol	the symbol
+*	Return value:			string
+********************************************************************************************/
+inline std::string StringTable::Name(int symbol) const
+{
+	return std::string(Data(symbol), entries[symbol].length);
+}
+
+/*******************************************************************************************
+*	Function Name:			Data
+*	Purpose:				the first byte of the string of a symbol, in its block
+*	Input Parameters:		int symbol	the symbol
+*	Return value:			const char *
+********************************************************************************************/
+inline const char *StringTable::Data(int symbol) const
+{
+	const Entry &entry = entries[symbol];
+	return blocks[entry.block].data() + entry.offset;
+}
+
+/*******************************************************************************************
+*	Function Name:			Length
+*	Purpose:				the length of the string of a symbol
+*	Input Parameters:		int symbol	the symbol
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t StringTable::Length(int symbol) const
+{
+	return entries[symbol].length;
+}
+
+/*******************************************************************************************
+*	Function Name:			Size
+*	Purpose:				the number of symbols given out
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int StringTable::Size() const
+{
+	return entries.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			Bytes
+*	Purpose:				the memory the blocks, entries, and hash table take
+*	Input Parameters:		none
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t StringTable::Bytes() const
+{
+	std::size_t bytes = entries.capacity() * sizeof(Entry) + slots.capacity() * sizeof(int);
+	for (unsigned i = 0; i < blocks.size(); i++)
+		bytes += blocks[i].capacity();
+	return bytes;
+}
+
+/*******************************************************************************************
+*	Function Name:			Clear
+*	Purpose:				removes every string and gives back the memory they took
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+inline void StringTable::Clear()
+{
+	std::vector<std::vector<char> >().swap(blocks);
+	std::vector<Entry>().swap(entries);
+	std::vector<int>().swap(slots);
+}
+
+/*******************************************************************************************
+*	Function Name:			Hash
+*	Purpose:				the 32 bit FNV-1a hash of a string
+*	Input Parameters:		const char *text		the first byte of the string
+*							size_t length			the length of the string
+*	Return value:			unsigned
+********************************************************************************************/
+inline unsigned StringTable::Hash(const char *text, std::size_t length)
+{
+	unsigned hash = 2166136261u;
+	for (std::size_t i = 0; i < length; i++)
+	{
+		hash ^= (unsigned char)text[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/*******************************************************************************************
+*	Function Name:			Probe
+*	Purpose:				probes the hash table from the slot of a string's hash until the
+*							string or an empty slot is found, comparing the bytes only of
+*							entries with the same hash and length
+*	Input Parameters:		const char *text		the first byte of the string
+*							size_t length			the length of the string
+*							unsigned hash			the hash of the string
+*	Return value:			size_t	the slot holding the string, or the empty slot it would
+*									go in
+********************************************************************************************/
+inline std::size_t StringTable::Probe(const char *text, std::size_t length, unsigned hash) const
+{
+	std::size_t mask = slots.size() - 1;
+	std::size_t slot = hash & mask;
+	while (slots[slot] != -1)
+	{
+		const Entry &entry = entries[slots[slot]];
+		if (entry.hash == hash && entry.length == length && memcmp(Data(slots[slot]), text, length) == 0)
+			break;
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/*******************************************************************************************
+*	Function Name:			Grow
+*	Purpose:				doubles the hash table and puts every symbol back into it by
+*							its stored hash
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+inline void StringTable::Grow()
+{
+	std::size_t size = slots.empty() ? 16 : 2 * slots.size();
+	std::size_t mask = size - 1;
+	slots.assign(size, -1);
+	for (unsigned symbol = 0; symbol < entries.size(); symbol++)
+	{
+		std::size_t slot = entries[symbol].hash & mask;
+		while (slots[slot] != -1)
+			slot = (slot + 1) & mask;
+		slots[slot] = symbol;
+	}
+}
+
+#endif // !STRINGTABLE_T
@@ -0,0 +1,86 @@
+/**************************************************************************************************
+*
+*   File name :			threadpool.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the ThreadPool class, implemented in threadpool.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		ThreadPool
+*
+*	A fixed set of worker threads used by the parallel graph algorithms. The thread that calls
+*	Run or ParallelFor works as worker 0 and the pool's threads as workers 1 to Size() - 1, so
+*	a pool of size 1 runs everything on the calling thread. Worker numbers let an algorithm keep
+*	per-worker state, such as one Workspace per worker, without locking.
+*
+*	Private data members:
+*		vector<thread> threads		the worker threads
+*		mutex lock					guards the job, generation, pending, and stopping
+*		condition_variable wake		signals the workers that a job or stop is waiting
+*		condition_variable done		signals Run that the last worker finished the job
+*		job							the job of the current Run
+*		unsigned generation			counts the jobs run, so a worker runs each job once
+*		int pending					the number of workers still running the current job
+*		bool stopping				set by the destructor to end the workers
+*
+*	Private member function:
+*		Worker				the loop each worker thread runs
+*
+*	Public member functions:
+*		ThreadPool			constructor, starting the worker threads
+*		~ThreadPool			destructor, stopping and joining the worker threads
+*		Size				the number of workers, including the calling thread
+*		Run					runs a job on every worker and waits for all of them
+*		ParallelFor			runs a loop body over 0 to count - 1 with the iterations
+*							handed out to the workers in chunks
+*
+****************************************************************************************************/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+class ThreadPool
+{
+public:
+	// Starts a pool of the given number of workers, counting the calling thread.
+	// 0 uses one worker per hardware thread.
+	explicit ThreadPool(int workers = 0);
+
+	~ThreadPool();	// Destructor
+
+	int Size() const;	// Number of workers, including the calling thread
+
+	// Calls job(worker) once on every worker and returns when all have finished
+	void Run(const std::function<void(int)> &job);
+
+	// Calls body(worker, i) for each i from 0 to count - 1, handing the iterations
+	// out grain at a time to whichever worker is free, and waits for all of them
+	template <class F>
+	void ParallelFor(int count, int grain, F body);
+
+private:
+	void Worker(int worker);
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+	std::vector<std::thread> threads;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable done;
+	std::function<void(int)> job;
+	unsigned generation;
+	int pending;
+	bool stopping;
+};
+#include "threadpool.t"
+#endif // !THREADPOOL_H
@@ -0,0 +1,161 @@
+/**************************************************************************************************
+*
+*   File name :			threadpool.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the thread pool defined in threadpool.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef THREADPOOL_T
+#define THREADPOOL_T
+
+/*******************************************************************************************
+*	Function Name:			ThreadPool()		the constructor
+*	Purpose:				starts the worker threads, which wait for a job
+*	Input Parameters:		int workers		the number of workers including the calling
+*											thread, 0 for one per hardware thread
+*	Return value:			none
+********************************************************************************************/
+inline ThreadPool::ThreadPool(int workers)
+{
+	generation = 0;
+	pending = 0;
+	stopping = false;
+
+	if (workers <= 0)
+		workers = std::thread::hardware_concurrency();
+	if (workers <= 0)
+		workers = 1;
+
+	//the calling thread is worker 0, so start one thread fewer
+	for (int i = 1; i < workers; i++)
+		threads.push_back(std::thread(&ThreadPool::Worker, this, i));
+}
+
+/*******************************************************************************************
+*	Function Name:			~ThreadPool()		the destructor
+*	Purpose:				tells the workers to stop and waits for them to end
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (unsigned i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
+
+/*******************************************************************************************
+*	Function Name:			Size
+*	Purpose:				the number of workers, including the calling thread
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int ThreadPool::Size() const
+{
+	return threads.size() + 1;
+}
+
+/*******************************************************************************************
+*	Function Name:			Run
+*	Purpose:				hands a job to every worker thread, runs it as worker 0 on the
+*							calling thread, and waits until every worker has finished it
+*	Input Parameters:		const function<void(int)> &job	called with the worker number
+*	Return value:			void
+********************************************************************************************/
+inline void ThreadPool::Run(const std::function<void(int)> &job)
+{
+	if (!threads.empty())
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		this->job = job;
+		pending = threads.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	job(0);
+
+	//wait for the worker threads to finish their share
+	std::unique_lock<std::mutex> guard(lock);
+	while (pending > 0)
+		done.wait(guard);
+}
+
+/*******************************************************************************************
+*	Function Name:			Worker
+*	Purpose:				waits for each new job, runs it, and reports back until the
+*							pool is stopped
+*	Input Parameters:		int worker		the worker number of this thread
+*	Return value:			void
+********************************************************************************************/
+inline void ThreadPool::Worker(int worker)
+{
+	unsigned seen = 0;		//the last job this worker ran
+	while (true)
+	{
+		std::function<void(int)> current;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			while (!stopping && generation == seen)
+				wake.wait(guard);
+			if (stopping)
+				return;
+			seen = generation;
+			current = job;
+		}
+
+		current(worker);
+
+		std::lock_guard<std::mutex> guard(lock);
+		if (--pending == 0)
+			done.notify_one();
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			ParallelFor
+*	Purpose:				runs a loop body over a range of iterations on all of the
+*							workers. A shared counter hands out chunks of grain iterations,
+*							so workers that finish early take more of the work. A range
+*							that fits in one chunk runs on the calling thread alone.
+*	Input Parameters:		int count	the number of iterations
+*							int grain	the number of iterations taken at a time
+*							F body		called as body(int worker, int i)
+*	Return value:			void
+********************************************************************************************/
+template <class F>
+void ThreadPool::ParallelFor(int count, int grain, F body)
+{
+	std::atomic<int> next(0);
+	if (grain < 1)
+		grain = 1;
+
+	//one chunk of work is not worth waking the workers for
+	if (count <= grain)
+	{
+		for (int i = 0; i < count; i++)
+			body(0, i);
+		return;
+	}
+
+	Run([&](int worker)
+	{
+		for (int start = next.fetch_add(grain); start < count; start = next.fetch_add(grain))
+		{
+			int end = start + grain < count ? start + grain : count;
+			for (int i = start; i < end; i++)
+				body(worker, i);
+		}
+	});
+}
+
+#endif // !THREADPOOL_T
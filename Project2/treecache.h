@@ -0,0 +1,152 @@
+/**************************************************************************************************
+*
+*   File name :			treecache.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the TreeCache class, implemented in treecache.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		TreeCache
+*
+*	A least recently used cache of shortest path trees, so repeated queries from the same
+*	source read the distances and previous vertices of an earlier search instead of searching
+*	again. A tree is keyed by its source and the kind of search that made it, since Dijkstra
+*	and Ford's algorithm differ when weights are negative. The trees together are kept under a
+*	limit on the bytes they take; the least recently used are evicted to make room.
+*
+*	The graph tells the cache of each change, along with its revision number after the change.
+*	A tree the change cannot affect is kept: a new edge that gives no vertex a shorter path, a
+*	removed edge the tree does not use, or a new vertex with no edges, which is just
+*	unreachable. Other trees are dropped. If the cache is told of a revision that does not
+*	follow the last one it saw, a change went by without it, and every tree is dropped.
+*
+*	Structs:
+*		ShortestPathTree	the distance and previous vertex of each vertex from a source, or
+*							the negative cycle that left the distances unbounded
+*		TreeCacheStats		counts of hits, misses, evictions, and trees kept or dropped
+*							across changes to the graph
+*
+*	Private data members:
+*		list<Entry> entries				the trees, most recently used first
+*		unordered_map<int, ...> index	the position in entries of each key
+*		size_t limit					the most bytes the trees may take
+*		size_t bytes					the bytes the trees take
+*		unsigned revision				the revision of the graph the trees are for
+*		TreeCacheStats stats			the counts
+*
+*	Private member functions:
+*		Key					the key of a source and kind of search
+*		Follows				whether a change is the next one after the trees' revision
+*		Evict				removes the least recently used trees until there is room
+*
+*	Public member functions:
+*		TreeCache			constructor for an empty cache with a memory limit
+*		Find				the tree of a source, if it is cached and current
+*		Insert				adds a tree, evicting others to make room
+*		Fits				whether a tree of a graph's size would be cached
+*		Clear				drops every tree
+*		EdgeAdded			keeps the trees a new edge does not shorten, drops the rest
+*		EdgeRemoved			keeps the trees that do not use a removed edge, drops the rest
+*		VertexAdded			extends the trees with an unreachable vertex
+*		SetLimit			changes the memory limit
+*		Limit				the memory limit
+*		Bytes				the memory the trees take
+*		Size				the number of trees
+*		Stats				the counts
+*
+****************************************************************************************************/
+
+#ifndef TREECACHE_H
+#define TREECACHE_H
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+#include "workspace.h"
+
+struct ShortestPathTree
+{
+	std::vector<double> dist;	// Distance from the source to each vertex, UNREACHABLE if none
+	std::vector<int> prev;		// Previous vertex on each shortest path, -1 for none
+	std::vector<int> cycle;		// A negative cycle reachable from the source; if it is not
+								// empty the distances are unbounded and dist and prev unused
+	void Assign(const Workspace &ws);	// Copies the distances and previous vertices of ws
+	std::size_t Bytes() const;	// Memory the tree takes
+	static std::size_t Bytes(int vertices);	// Memory a tree of that many vertices takes, without a cycle
+};
+
+struct TreeCacheStats
+{
+	unsigned hits = 0;			// Finds that returned a tree
+	unsigned misses = 0;		// Finds that did not
+	unsigned evictions = 0;		// Trees removed to stay under the memory limit
+	unsigned kept = 0;			// Trees kept through a change to the graph
+	unsigned dropped = 0;		// Trees dropped because of a change to the graph
+};
+
+enum TreeKind { DIJKSTRA_TREE, FORD_TREE };
+
+const std::size_t DEFAULT_TREE_CACHE_BYTES = 16 << 20;
+
+class TreeCache
+{
+public:
+	TreeCache(std::size_t limit = DEFAULT_TREE_CACHE_BYTES);	// Constructor
+
+	// The tree of kind from source, or NULL. revision is the graph's current revision;
+	// if the cache has not seen it every tree is dropped first. Counts a hit or a miss.
+	const ShortestPathTree *Find(TreeKind kind, int source, unsigned revision);
+
+	// Caches a copy of tree as the tree of kind from source for the given revision,
+	// evicting the least recently used trees to stay under the limit. A tree larger
+	// than the limit is not cached.
+	void Insert(TreeKind kind, int source, const ShortestPathTree &tree, unsigned revision);
+
+	// Whether a tree of a graph of that many vertices is small enough to be cached. A
+	// search whose tree would not fit need not find the whole tree.
+	bool Fits(int vertices) const;
+
+	// Drops every tree
+	void Clear();
+
+	// The graph, now at revision, has a new edge from vertex index from to vertex index
+	// to. Keeps the trees in which it shortens no path. O(trees)
+	void EdgeAdded(int from, int to, double weight, unsigned revision);
+
+	// The graph, now at revision, lost an edge from vertex index from to vertex index to.
+	// Keeps the trees that do not use it. O(trees)
+	void EdgeRemoved(int from, int to, unsigned revision);
+
+	// The graph, now at revision, has a new vertex with no edges at the next index.
+	// Every tree gains it as an unreachable vertex. O(trees)
+	void VertexAdded(unsigned revision);
+
+	void SetLimit(std::size_t bytes);		// Changes the memory limit, evicting trees if needed
+	std::size_t Limit() const;				// Most bytes the trees may take
+	std::size_t Bytes() const;				// Bytes the trees take
+	int Size() const;						// Number of trees
+	const TreeCacheStats &Stats() const;	// Hit, miss, eviction, and invalidation counts
+
+private:
+	struct Entry
+	{
+		int key;
+		ShortestPathTree tree;
+	};
+
+	static int Key(TreeKind kind, int source);
+	bool Follows(unsigned next);
+	void Evict(std::size_t room);
+	std::list<Entry> entries;
+	std::unordered_map<int, std::list<Entry>::iterator> index;
+	std::size_t limit;
+	std::size_t bytes;
+	unsigned revision;
+	TreeCacheStats stats;
+};
+#include "treecache.t"
+#endif // !TREECACHE_H
@@ -0,0 +1,361 @@
+/**************************************************************************************************
+*
+*   File name :			treecache.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the TreeCache class defined in treecache.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef TREECACHE_T
+#define TREECACHE_T
+
+/*******************************************************************************************
+*	Function Name:			Assign
+*	Purpose:				copies the distances and previous vertices of a finished search
+*	Input Parameters:		const Workspace &ws		the search
+*	Return value:			void
+********************************************************************************************/
+inline void ShortestPathTree::Assign(const Workspace &ws)
+{
+	dist.resize(ws.Size());
+	prev.resize(ws.Size());
+	for (int v = 0; v < ws.Size(); v++)
+	{
+		dist[v] = ws.Dist(v);
+		prev[v] = ws.Prev(v);
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			Bytes
+*	Purpose:				the memory a shortest path tree takes
+*	Input Parameters:		none
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t ShortestPathTree::Bytes() const
+{
+	return sizeof(ShortestPathTree) + dist.size() * sizeof(double) + (prev.size() + cycle.size()) * sizeof(int);
+}
+
+/*******************************************************************************************
+*	Function Name:			Bytes
+*	Purpose:				the memory a shortest path tree of a graph takes, when the
+*							tree has no negative cycle
+*	Input Parameters:		int vertices	the number of vertices in the graph
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t ShortestPathTree::Bytes(int vertices)
+{
+	return sizeof(ShortestPathTree) + vertices * (sizeof(double) + sizeof(int));
+}
+
+/*******************************************************************************************
+*	Function Name:			TreeCache()			the constructor
+*	Purpose:				creates an empty cache
+*	Input Parameters:		size_t limit	the most bytes the trees may take
+*	Return value:			none
+********************************************************************************************/
+inline TreeCache::TreeCache(std::size_t limit)
+{
+	this->limit = limit;
+	bytes = 0;
+	revision = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Key
+*	Purpose:				the key of a source and kind of search
+*	Input Parameters:		TreeKind kind	the kind of search
+*							int source		index of the source vertex
+*	Return value:			int
+********************************************************************************************/
+inline int TreeCache::Key(TreeKind kind, int source)
+{
+	return source * 2 + kind;
+}
+
+/*******************************************************************************************
+*	Function Name:			Find
+*	Purpose:				the tree of a source, moved to the front of the use order. The
+*							trees are dropped first if the graph is at a revision the cache
+*							has not followed.
+*	Input Parameters:		TreeKind kind		the kind of search
+*							int source			index of the source vertex
+*							unsigned revision	the graph's current revision
+*	Return value:			const ShortestPathTree *	the tree, NULL if it is not cached
+********************************************************************************************/
+inline const ShortestPathTree *TreeCache::Find(TreeKind kind, int source, unsigned revision)
+{
+	if (revision != this->revision)
+	{
+		Clear();
+		this->revision = revision;
+	}
+
+	std::unordered_map<int, std::list<Entry>::iterator>::iterator found = index.find(Key(kind, source));
+	if (found == index.end())
+	{
+		stats.misses++;
+		return NULL;
+	}
+
+	stats.hits++;
+	entries.splice(entries.begin(), entries, found->second);
+	return &found->second->tree;
+}
+
+/*******************************************************************************************
+*	Function Name:			Insert
+*	Purpose:				caches a copy of a tree at the front of the use order, replacing
+*							any tree with the same key
+*	Input Parameters:		TreeKind kind					the kind of search
+*							int source						index of the source vertex
+*							const ShortestPathTree &tree	the tree
+*							unsigned revision				the revision the tree is for
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::Insert(TreeKind kind, int source, const ShortestPathTree &tree, unsigned revision)
+{
+	if (revision != this->revision)
+	{
+		Clear();
+		this->revision = revision;
+	}
+
+	//replace the old tree
+	int key = Key(kind, source);
+	std::unordered_map<int, std::list<Entry>::iterator>::iterator found = index.find(key);
+	if (found != index.end())
+	{
+		bytes -= found->second->tree.Bytes();
+		entries.erase(found->second);
+		index.erase(found);
+	}
+
+	if (tree.Bytes() > limit)
+		return;
+
+	Evict(tree.Bytes());
+	Entry entry = { key, tree };
+	entries.push_front(entry);
+	index[key] = entries.begin();
+	bytes += tree.Bytes();
+}
+
+/*******************************************************************************************
+*	Function Name:			Fits
+*	Purpose:				tests whether a tree of a graph would be kept by Insert, which
+*							drops trees larger than the limit
+*	Input Parameters:		int vertices	the number of vertices in the graph
+*	Return value:			bool
+********************************************************************************************/
+inline bool TreeCache::Fits(int vertices) const
+{
+	return ShortestPathTree::Bytes(vertices) <= limit;
+}
+
+/*******************************************************************************************
+*	Function Name:			Clear
+*	Purpose:				drops every tree
+*	Input Parameters:		none
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::Clear()
+{
+	stats.dropped += entries.size();
+	entries.clear();
+	index.clear();
+	bytes = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Follows
+*	Purpose:				whether a change brings the graph to the revision after the one
+*							the trees are for. If it does not, some change went by without
+*							the cache, so every tree is dropped.
+*	Input Parameters:		unsigned next	the graph's revision after the change
+*	Return value:			bool	true if the trees can be checked against the change
+********************************************************************************************/
+inline bool TreeCache::Follows(unsigned next)
+{
+	bool follows = next == revision + 1;
+	if (!follows)
+		Clear();
+	revision = next;
+	return follows;
+}
+
+/*******************************************************************************************
+*	Function Name:			EdgeAdded
+*	Purpose:				keeps the trees in which the new edge does not shorten the path
+*							to its end, which are still shortest path trees, and drops the
+*							others. A tree with a negative cycle keeps it, since adding an
+*							edge cannot make the cycle unreachable. A new negative cycle
+*							through the edge would shorten the path to its end.
+*	Input Parameters:		int from			the start of the edge
+*							int to				the end of the edge
+*							double weight		the weight of the edge
+*							unsigned revision	the graph's revision after the change
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::EdgeAdded(int from, int to, double weight, unsigned revision)
+{
+	if (!Follows(revision))
+		return;
+
+	for (std::list<Entry>::iterator it = entries.begin(); it != entries.end();)
+	{
+		const ShortestPathTree &tree = it->tree;
+		if (tree.cycle.empty() && tree.dist[from] + weight < tree.dist[to])
+		{
+			stats.dropped++;
+			bytes -= tree.Bytes();
+			index.erase(it->key);
+			it = entries.erase(it);
+		}
+		else
+		{
+			stats.kept++;
+			it++;
+		}
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			EdgeRemoved
+*	Purpose:				keeps the trees that do not reach the end of the removed edge
+*							through it, since their paths are all still there and no path
+*							became shorter, and drops the others. A tree with a negative
+*							cycle is dropped, as the edge may have been how it was reached.
+*	Input Parameters:		int from			the start of the edge
+*							int to				the end of the edge
+*							unsigned revision	the graph's revision after the change
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::EdgeRemoved(int from, int to, unsigned revision)
+{
+	if (!Follows(revision))
+		return;
+
+	for (std::list<Entry>::iterator it = entries.begin(); it != entries.end();)
+	{
+		const ShortestPathTree &tree = it->tree;
+		if (!tree.cycle.empty() || tree.prev[to] == from)
+		{
+			stats.dropped++;
+			bytes -= tree.Bytes();
+			index.erase(it->key);
+			it = entries.erase(it);
+		}
+		else
+		{
+			stats.kept++;
+			it++;
+		}
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			VertexAdded
+*	Purpose:				extends every tree with the new vertex, which no path reaches
+*							yet, evicting trees if the larger trees pass the limit
+*	Input Parameters:		unsigned revision	the graph's revision after the change
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::VertexAdded(unsigned revision)
+{
+	if (!Follows(revision))
+		return;
+
+	for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); it++)
+	{
+		bytes -= it->tree.Bytes();
+		it->tree.dist.push_back(UNREACHABLE);
+		it->tree.prev.push_back(-1);
+		bytes += it->tree.Bytes();
+		stats.kept++;
+	}
+	Evict(0);
+}
+
+/*******************************************************************************************
+*	Function Name:			Evict
+*	Purpose:				removes the least recently used trees until the trees and room
+*							more bytes fit under the limit
+*	Input Parameters:		size_t room		the bytes to make room for
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::Evict(std::size_t room)
+{
+	while (!entries.empty() && bytes + room > limit)
+	{
+		stats.evictions++;
+		bytes -= entries.back().tree.Bytes();
+		index.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+/*******************************************************************************************
+*	Function Name:			SetLimit
+*	Purpose:				changes the most bytes the trees may take, evicting the least
+*							recently used trees if they take more. A limit of 0 turns the
+*							cache off.
+*	Input Parameters:		size_t bytes	the new limit
+*	Return value:			void
+********************************************************************************************/
+inline void TreeCache::SetLimit(std::size_t bytes)
+{
+	limit = bytes;
+	Evict(0);
+}
+
+/*******************************************************************************************
+*	Function Name:			Limit
+*	Purpose:				the most bytes the trees may take
+*	Input Parameters:		none
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t TreeCache::Limit() const
+{
+	return limit;
+}
+
+/*******************************************************************************************
+*	Function Name:			Bytes
+*	Purpose:				the bytes the cached trees take
+*	Input Parameters:		none
+*	Return value:			size_t
+********************************************************************************************/
+inline std::size_t TreeCache::Bytes() const
+{
+	return bytes;
+}
+
+/*******************************************************************************************
+*	Function Name:			Size
+*	Purpose:				the number of cached trees
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int TreeCache::Size() const
+{
+	return entries.size();
+}
+
+/*******************************************************************************************
+*	Function Name:			Stats
+*	Purpose:				the hit, miss, eviction, and invalidation counts
+*	Input Parameters:		none
+*	Return value:			const TreeCacheStats &
+********************************************************************************************/
+inline const TreeCacheStats &TreeCache::Stats() const
+{
+	return stats;
+}
+
+#endif // !TREECACHE_T
@@ -0,0 +1,86 @@
+/**************************************************************************************************
+*
+*   File name :			visitor.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the search visitors, implemented in visitor.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	A visitor is told about the events inside the main loop of a search, so tracing and
+*	instrumentation stay out of the algorithms. Any type with the five hooks below can be a
+*	visitor; the engines call the hooks directly on the template type, so a hook with an empty
+*	body is inlined away and a search with a NullVisitor costs only the computation. Each hook
+*	gets the query's Workspace so it can read the labels as they are when the event happens.
+*
+*	Hooks:
+*		Discover			a vertex is reached for the first time, or queued again
+*		Examine				a vertex is taken off the queue or stack to have its edges scanned
+*		Relax				an edge u to v lowered the label of v
+*		Settle				a vertex's label is final, such as a popped Dijkstra vertex or a
+*							vertex joining the spanning tree
+*		Finish				all of a depth first vertex's descendants are done, or all of
+*							the edges of a vertex that joined the spanning tree are relaxed
+*
+*	Structs:
+*		NullVisitor			a visitor whose hooks all do nothing, used when none is given.
+*							Other visitors derive from it and hide only the hooks they need
+*
+*	Class Names:
+*		FordTrace			prints the queue trace of Graph::FordShortestPath
+*		PrimTrace			prints the vertex table of Graph::MST each time a vertex joins
+*							the tree and its edges are relaxed
+*
+*	The trace visitors work on any graph type Adj with a VertexCount() and a Name(int v).
+*
+****************************************************************************************************/
+
+#ifndef VISITOR_H
+#define VISITOR_H
+#include "workspace.h"
+
+struct NullVisitor
+{
+	void Discover(int, const Workspace &) {}
+	void Examine(int, const Workspace &) {}
+	void Relax(int, int, double, const Workspace &) {}
+	void Settle(int, const Workspace &) {}
+	void Finish(int, const Workspace &) {}
+};
+
+template <class Adj>
+class FordTrace : public NullVisitor
+{
+public:
+	FordTrace(const Adj &g);		// Constructor
+
+	// Prints the iteration number and the vertex taken off the queue
+	void Examine(int v, const Workspace &ws);
+
+	// Prints a vertex being added to the queue
+	void Discover(int v, const Workspace &ws);
+
+private:
+	const Adj &graph;
+	int iterations;
+};
+
+template <class Adj>
+class PrimTrace : public NullVisitor
+{
+public:
+	PrimTrace(const Adj &g);		// Constructor
+
+	// Prints the previous vertex, edge cost, tree mark, and distance of every
+	// vertex once the edges of a vertex that joined the tree are relaxed. O(V) per
+	// call, so O(V^2) over a whole tree.
+	void Finish(int v, const Workspace &ws);
+
+private:
+	const Adj &graph;
+};
+#include "visitor.t"
+#endif // !VISITOR_H
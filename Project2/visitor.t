@@ -0,0 +1,111 @@
+/**************************************************************************************************
+*
+*   File name :			visitor.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Templated implementations of the trace visitors defined in visitor.h. They print the same
+*	trace the Graph member functions always have, so a traced run and a silent run differ only
+*	in the visitor passed in.
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef VISITOR_T
+#define VISITOR_T
+#include <iostream>
+#include <iomanip>
+#include <climits>
+
+/*******************************************************************************************
+*	Function Name:			FordTrace()			the constructor
+*	Purpose:				creates a trace of a search of a graph
+*	Input Parameters:		const Adj &g	the graph being searched
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+FordTrace<Adj>::FordTrace(const Adj &g) : graph(g), iterations(0)
+{
+
+}
+
+/*******************************************************************************************
+*	Function Name:			Examine
+*	Purpose:				prints the iteration number and the vertex popped from the queue
+*	Input Parameters:		int v				index of the popped vertex
+*							const Workspace &ws	the workspace of the search
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void FordTrace<Adj>::Examine(int v, const Workspace &)
+{
+	std::cout << "\n\nIteration " << iterations << "\n";
+	iterations++;
+	std::cout << graph.Name(v) << " popped from the queue." << std::endl;
+}
+
+/*******************************************************************************************
+*	Function Name:			Discover
+*	Purpose:				prints a vertex being added to the queue
+*	Input Parameters:		int v				index of the queued vertex
+*							const Workspace &ws	the workspace of the search
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void FordTrace<Adj>::Discover(int v, const Workspace &)
+{
+	std::cout << graph.Name(v) << " added to the queue." << std::endl;
+}
+
+/*******************************************************************************************
+*	Function Name:			PrimTrace()			the constructor
+*	Purpose:				creates a trace of a spanning tree search of a graph
+*	Input Parameters:		const Adj &g	the graph being searched
+*	Return value:			none
+********************************************************************************************/
+template <class Adj>
+PrimTrace<Adj>::PrimTrace(const Adj &g) : graph(g)
+{
+
+}
+
+/*******************************************************************************************
+*	Function Name:			Finish
+*	Purpose:				prints the information for each vertex after a vertex joins the
+*							tree and its edges are relaxed, so the table shows the cheaper
+*							edges it brought. Distances and costs of INT_MAX or more are
+*							printed as INF.
+*							The lines are only flushed at the end of the table.
+*	Input Parameters:		int v				index of the vertex that joined the tree
+*							const Workspace &ws	the workspace of the search
+*	Return value:			void
+********************************************************************************************/
+template <class Adj>
+void PrimTrace<Adj>::Finish(int, const Workspace &ws)
+{
+	using namespace std;
+
+	cout << "\n";
+	for (int i = 0; i < graph.VertexCount(); i++)
+	{
+		cout << "Vertex Name:\t" << left << setw(15) << graph.Name(i);
+		if (ws.Prev(i) == -1)
+			cout << "Previous Node: " << setw(15) << "None";
+		else
+			cout << "Previous Node: " << setw(15) << graph.Name(ws.Prev(i));
+		if (ws.Cost(i) >= INT_MAX)
+			cout << setw(20) << "Distance from previous:\t" << setw(10) << "INF";
+		else
+			cout << setw(20) << "Distance from previous:\t" << setw(10) << ws.Cost(i);
+		cout << "Components:\t" << ws.Mark(i);
+		if (ws.Dist(i) >= INT_MAX)
+			cout << "\tDistance from source:\t" << setw(10) << "INF";
+		else
+			cout << "\tDistance from source:\t" << setw(10) << ws.Dist(i);
+		cout << "\n";
+	}
+	cout << "--------------------------------------------------------------------------------------------------------------------------------------------------------" << endl;
+}
+
+#endif // !VISITOR_T
@@ -0,0 +1,102 @@
+/**************************************************************************************************
+*
+*   File name :			workspace.h
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Header file for the Workspace class, implemented in workspace.t
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+*
+*	Class Name:		Workspace
+*
+*	The per-query scratch state of the graph algorithms: a distance, an edge cost, a previous
+*	vertex, and a mark for each vertex index, plus a reusable heap. A graph is only read during
+*	a query, so any number of queries can run on one graph at the same time as long as each has
+*	its own Workspace.
+*
+*	Starting a query does not clear the arrays. Each vertex has a stamp, and a vertex whose stamp
+*	is not the current query's reads as untouched (distance and cost UNREACHABLE, previous -1,
+*	mark 0). Starting a query only advances the current stamp, so a query that reaches k vertices
+*	costs O(k) to reset rather than O(V).
+*
+*	Constants:
+*		UNREACHABLE			the distance of a vertex that cannot be reached from the source
+*
+*	Private data members:
+*		vector<unsigned> stamp		the query each vertex was last touched in
+*		vector<double> dist			the distance of each vertex
+*		vector<double> cost			the cost of the edge each vertex was reached by
+*		vector<int> prev			the previous vertex of each vertex
+*		vector<int> mark			a per-algorithm mark, such as visited or in the tree
+*		vector<int> touched			the vertices touched in the current query
+*		unsigned epoch				the stamp of the current query
+*		MinHeap<double> heap		the priority queue reused across queries
+*
+*	Private member function:
+*		Touch				gives a vertex its untouched values the first time a query uses it
+*
+*	Public member functions:
+*		Workspace			constructor for an empty workspace
+*		Begin				starts a new query over a graph of n vertices
+*		Size				the number of vertices of the current query
+*		Dist/SetDist		read and write the distance of a vertex
+*		Cost/SetCost		read and write the cost of the edge a vertex was reached by
+*		Prev/SetPrev		read and write the previous vertex of a vertex
+*		Mark/SetMark		read and write the mark of a vertex
+*		Touched				the vertices touched in the current query
+*		Heap				the heap of the workspace, emptied by Begin
+*
+****************************************************************************************************/
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+#include <vector>
+#include <limits>
+#include "minheap.h"
+
+// Distance of a vertex that cannot be reached from the source
+const double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+class Workspace
+{
+public:
+	Workspace();	// Constructor
+
+	// Starts a new query over vertex indices 0 to n - 1. Every vertex reads as
+	// untouched afterwards. O(1) amortized unless the graph has grown.
+	void Begin(int n);
+
+	int Size() const;	// Number of vertices of the current query
+
+	double Dist(int v) const;
+	void SetDist(int v, double d);
+	double Cost(int v) const;
+	void SetCost(int v, double c);
+	int Prev(int v) const;
+	void SetPrev(int v, int p);
+	int Mark(int v) const;
+	void SetMark(int v, int m);
+
+	// Vertices given a value during the current query, in the order they were touched
+	const std::vector<int> &Touched() const;
+
+	// Heap reused by each query, empty after Begin
+	MinHeap<double> &Heap();
+
+private:
+	void Touch(int v);
+	std::vector<unsigned> stamp;
+	std::vector<double> dist;
+	std::vector<double> cost;
+	std::vector<int> prev;
+	std::vector<int> mark;
+	std::vector<int> touched;
+	unsigned epoch;
+	int size;
+	MinHeap<double> heap;
+};
+#include "workspace.t"
+#endif // !WORKSPACE_H
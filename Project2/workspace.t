@@ -0,0 +1,208 @@
+/**************************************************************************************************
+*
+*   File name :			workspace.t
+*
+*	Programmer:  		Jeremy Atkins
+*
+*   Implementations of the functions for the per-query workspace defined in workspace.h
+*
+*   Date Written:		in the past
+*
+*   Date Last Revised:	4/8/2019
+****************************************************************************************************/
+#ifndef WORKSPACE_T
+#define WORKSPACE_T
+
+/*******************************************************************************************
+*	Function Name:			Workspace()			the constructor
+*	Purpose:				creates a workspace sized for no vertices
+*	Input Parameters:		none
+*	Return value:			none
+********************************************************************************************/
+inline Workspace::Workspace()
+{
+	epoch = 0;
+	size = 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			Begin
+*	Purpose:				starts a new query by advancing the stamp, so the values of the
+*							previous query read as untouched without being cleared
+*	Input Parameters:		int n	the number of vertices in the graph
+*	Return value:			void
+********************************************************************************************/
+inline void Workspace::Begin(int n)
+{
+	//grow the arrays if the graph is bigger than any graph before
+	if ((int)stamp.size() < n)
+	{
+		stamp.resize(n, 0);
+		dist.resize(n);
+		cost.resize(n);
+		prev.resize(n);
+		mark.resize(n);
+	}
+	size = n;
+
+	//when the stamp wraps around, old stamps could match again, so clear them
+	epoch++;
+	if (epoch == 0)
+	{
+		stamp.assign(stamp.size(), 0);
+		epoch = 1;
+	}
+
+	touched.clear();
+	heap.Reset(n);
+}
+
+/*******************************************************************************************
+*	Function Name:			Size
+*	Purpose:				the number of vertices of the current query
+*	Input Parameters:		none
+*	Return value:			int
+********************************************************************************************/
+inline int Workspace::Size() const
+{
+	return size;
+}
+
+/*******************************************************************************************
+*	Function Name:			Touch
+*	Purpose:				gives a vertex its untouched values if the current query has not
+*							touched it yet
+*	Input Parameters:		int v	the vertex index
+*	Return value:			void
+********************************************************************************************/
+inline void Workspace::Touch(int v)
+{
+	if (stamp[v] == epoch)
+		return;
+	stamp[v] = epoch;
+	dist[v] = UNREACHABLE;
+	cost[v] = UNREACHABLE;
+	prev[v] = -1;
+	mark[v] = 0;
+	touched.push_back(v);
+}
+
+/*******************************************************************************************
+*	Function Name:			Dist
+*	Purpose:				the distance of a vertex in the current query
+*	Input Parameters:		int v	the vertex index
+*	Return value:			double	UNREACHABLE if the vertex has not been touched
+********************************************************************************************/
+inline double Workspace::Dist(int v) const
+{
+	return stamp[v] == epoch ? dist[v] : UNREACHABLE;
+}
+
+/*******************************************************************************************
+*	Function Name:			SetDist
+*	Purpose:				sets the distance of a vertex in the current query
+*	Input Parameters:		int v		the vertex index
+*							double d	the distance
+*	Return value:			void
+********************************************************************************************/
+inline void Workspace::SetDist(int v, double d)
+{
+	Touch(v);
+	dist[v] = d;
+}
+
+/*******************************************************************************************
+*	Function Name:			Cost
+*	Purpose:				the cost of the edge a vertex was reached by
+*	Input Parameters:		int v	the vertex index
+*	Return value:			double	UNREACHABLE if the vertex has not been touched
+********************************************************************************************/
+inline double Workspace::Cost(int v) const
+{
+	return stamp[v] == epoch ? cost[v] : UNREACHABLE;
+}
+
+/*******************************************************************************************
+*	Function Name:			SetCost
+*	Purpose:				sets the cost of the edge a vertex was reached by
+*	Input Parameters:		int v		the vertex index
+*							double c	the edge cost
+*	Return value:			void
+********************************************************************************************/
+inline void Workspace::SetCost(int v, double c)
+{
+	Touch(v);
+	cost[v] = c;
+}
+
+/*******************************************************************************************
+*	Function Name:			Prev
+*	Purpose:				the previous vertex of a vertex in the current query
+*	Input Parameters:		int v	the vertex index
+*	Return value:			int		-1 if there is none
+********************************************************************************************/
+inline int Workspace::Prev(int v) const
+{
+	return stamp[v] == epoch ? prev[v] : -1;
+}
+
+/*******************************************************************************************
+*	Function Name:			SetPrev
+*	Purpose:				sets the previous vertex of a vertex in the current query
+*	Input Parameters:		int v	the vertex index
+*							int p	the previous vertex index
+*	Return value:			void
+********************************************************************************************/
+inline void Workspace::SetPrev(int v, int p)
+{
+	Touch(v);
+	prev[v] = p;
+}
+
+/*******************************************************************************************
+*	Function Name:			Mark
+*	Purpose:				the mark of a vertex in the current query
+*	Input Parameters:		int v	the vertex index
+*	Return value:			int		0 if the vertex has not been touched
+********************************************************************************************/
+inline int Workspace::Mark(int v) const
+{
+	return stamp[v] == epoch ? mark[v] : 0;
+}
+
+/*******************************************************************************************
+*	Function Name:			SetMark
+*	Purpose:				sets the mark of a vertex in the current query
+*	Input Parameters:		int v	the vertex index
+*							int m	the mark
+*	Return value:			void
+********************************************************************************************/
+inline void Workspace::SetMark(int v, int m)
+{
+	Touch(v);
+	mark[v] = m;
+}
+
+/*******************************************************************************************
+*	Function Name:			Touched
+*	Purpose:				the vertices touched in the current query
+*	Input Parameters:		none
+*	Return value:			const vector<int> &
+********************************************************************************************/
+inline const std::vector<int> &Workspace::Touched() const
+{
+	return touched;
+}
+
+/*******************************************************************************************
+*	Function Name:			Heap
+*	Purpose:				the heap reused by each query
+*	Input Parameters:		none
+*	Return value:			MinHeap<double> &
+********************************************************************************************/
+inline MinHeap<double> &Workspace::Heap()
+{
+	return heap;
+}
+
+#endif // !WORKSPACE_T